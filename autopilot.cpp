@@ -0,0 +1,629 @@
+// Autopilot.cpp
+// A paddle controller that plays the game by working out where each ball will come down
+
+// Include the autopilot header
+#include "autopilot.h"
+
+// Include the ball shapes and paddle profiles for where a ball meets the paddle
+#include "ballshape.h"
+#include "profiles.h"
+
+// Include the bit helpers for counting the bricks left in each column
+#include "bitops.h"
+
+// Include standard library
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <algorithm>
+
+bool SoonerLanding(const PilotBall &a, const PilotBall &b) // Sort order for the balls to follow
+{
+	return a.bound < b.bound;
+}
+
+void ResetAutopilot(Autopilot &pilot, unsigned long long seed) // Start the autopilot afresh, seed picks where it catches the balls
+{
+	int n; // Counter
+
+	// The scratch game only ever holds the ball being followed, with no coins, explosions or bullets
+	{
+		GameSelection select(pilot.scratch); // Selected while it is set up
+
+		SetPoolSizes(1, 0, 0, 0);
+		ResetTimers();
+		ClearEvents();
+		pilot.scratch.gameHooks.sound = NULL;
+		pilot.scratch.gameHooks.levelLoaded = NULL;
+		pilot.scratch.gameHooks.events = NULL;
+		pilot.scratch.magnetic = 0; // The paddle is never reached, but nothing should stick to it
+		pilot.scratch.livesRemaining = 0;
+		pilot.scratch.levelComplete = false;
+		pilot.timersUsed = false;
+	}
+
+	for(n = 0; n < AUTOPILOTPATHS; n++)
+	{
+		pilot.paths[n].ball.slot = -1;
+		pilot.paths[n].states.clear();
+	}
+	pilot.nextPath = 0;
+	memset(pilot.seenRows, 0, sizeof(pilot.seenRows));
+	memset(pilot.seenGrey, 0, sizeof(pilot.seenGrey));
+	memset(pilot.seenExplosive, 0, sizeof(pilot.seenExplosive));
+	pilot.bricks = 0;
+
+	SeedRandomStream(pilot.aim, seed, 0);
+	pilot.aimOffset = 0;
+	pilot.aimBricks = -1;
+	pilot.aimMisses = 0;
+	pilot.targetX = -1;
+	pilot.targetY = -1;
+	pilot.lastLanding = 0;
+	pilot.landingBall.slot = -1;
+	pilot.landingTicks = -1;
+	pilot.landingX = 0;
+	pilot.landingFrom = 0;
+	pilot.calls = 0;
+	pilot.predictions = 0;
+	pilot.reused = 0;
+	pilot.steps = 0;
+}
+
+TickInput AutopilotInput(Autopilot &pilot) // Work out the input for the next game update of the selected game
+{
+	TickInput input = {0, false};
+	int n; // Counter
+	int ticks; // Game updates before a ball lands
+	int landX; // Where it lands
+	int best = -1; // Game updates before the ball being caught lands (-1 = none found)
+	int bestX = 0; // Where it lands
+	unsigned int bestFrom = 0; // Hash of it as it starts the game update it lands in
+	int bestBall = -1; // The ball
+	bool reachable = false; // Can the paddle get under it in time
+	int lowest = -1; // The lowest ball in flight, followed if none lands soon enough
+	int half = TILESIZE + GetPaddleSize()*TILESIZE/2; // Half the paddle's length
+	int centre = GetPaddlePosition() + half; // Centre of the paddle
+	int target; // Where the paddle's centre is headed
+	int step = (GetPaddleSpeed() + TickScale() - 1) / TickScale(); // Most pixels the paddle moves in a game update
+	PilotBall waiting; // A ball to follow
+
+	assert(game != NULL && game != &pilot.scratch); // It steers the game being played, never its own scratch game
+	pilot.calls++;
+	WatchBricks(pilot);
+
+	// Release any stuck balls straight away, and keep the lasers firing while there are any
+	pilot.order.clear();
+	for(n = 0; n < game->balls.Count(); n++)
+	{
+		if(game->balls[n].stuck)
+		{
+			input.fire = true;
+			continue;
+		}
+		waiting.ball = n;
+		waiting.bound = LandingBound(n);
+		pilot.order.push_back(waiting);
+		if(lowest == -1 || game->balls[n].y > game->balls[lowest].y)
+		{
+			lowest = n;
+		}
+	}
+	if(game->laser > 0)
+	{
+		input.fire = true;
+	}
+	std::sort(pilot.order.begin(), pilot.order.end(), SoonerLanding);
+
+	// Follow the balls soonest possible landing first, looking for the soonest the paddle can get under
+	for(n = 0; n < (int)pilot.order.size(); n++)
+	{
+		if(reachable && pilot.order[n].bound >= best) // If no ball left can land before the one being caught...
+		{
+			break;
+		}
+		ticks = PredictLanding(pilot, pilot.order[n].ball, reachable ? best : AUTOPILOTHORIZON*TickScale(), landX);
+		if(ticks == -1)
+		{
+			continue;
+		}
+		if(abs(landX - centre) - (half - TILESIZE/2) <= PaddleReach(ticks)) // If the paddle can get under it in time...
+		{
+			if(!reachable || ticks < best)
+			{
+				best = ticks;
+				bestX = landX;
+				bestFrom = pilot.lastLanding;
+				bestBall = pilot.order[n].ball;
+				reachable = true;
+			}
+		}
+		else if(!reachable && (best == -1 || ticks < best)) // Chase the soonest one if none can be reached
+		{
+			best = ticks;
+			bestX = landX;
+			bestFrom = pilot.lastLanding;
+			bestBall = pilot.order[n].ball;
+		}
+	}
+
+	if(best == -1) // If no ball comes down soon (or none is in flight)...
+	{
+		pilot.landingTicks = -1;
+		if(lowest == -1)
+		{
+			return input;
+		}
+		target = game->balls[lowest].x + 8; // Stay under the lowest ball
+	}
+	else
+	{
+		if(best > pilot.landingTicks) // A ball that has just rebounded, or a new one, is aimed afresh
+		{
+			pilot.aimOffset = reachable ? AimOffset(pilot, bestBall, bestX) : 0;
+		}
+		pilot.landingBall = game->balls.Handle(bestBall);
+		pilot.landingTicks = best;
+		pilot.landingX = bestX;
+		pilot.landingFrom = bestFrom;
+		target = bestX - pilot.aimOffset;
+
+		// Never aim so far along the paddle that it can't get there in time, catching the ball matters more
+		if(reachable && abs(target - centre) > PaddleReach(best))
+		{
+			target = target > centre ? centre + PaddleReach(best) : centre - PaddleReach(best);
+			if(abs(bestX - target) > half - TILESIZE/2) // Still on the paddle
+			{
+				target = target > bestX ? bestX + half - TILESIZE/2 : bestX - (half - TILESIZE/2);
+			}
+		}
+	}
+
+	// Head for the target, stopping once the paddle is as close as one more move would get it
+	if(target - centre > step/2)
+	{
+		input.paddleDirection = 1;
+	}
+	else if(centre - target > step/2)
+	{
+		input.paddleDirection = -1;
+	}
+	return input;
+}
+
+int PredictLanding(Autopilot &pilot, int num, int limit, int &landX) // Game updates before ball num of the selected game comes down onto the paddle's top row
+{
+	GameState &playing = *game; // The game being played
+	GameState &scratch = pilot.scratch; // The game the ball is moved in
+	const Ball &ball = playing.balls[num]; // The ball followed
+	PoolHandle handle = playing.balls.Handle(num); // The ball's handle, which its path is kept under
+	PilotPath &path = FindPath(pilot, handle); // Its path
+	int top = GetPaddleProfile(PADDLEPROFILE_DOWN, playing.paddleSize).top; // The paddle's top row
+	int along = playing.gameTick - path.start; // Game updates the ball has moved along its path
+	int ticks = 0; // Game updates moved so far
+	int scale = TickScale(); // Game updates in a 20 a second update
+
+	// If the ball is where its path said it would be, the path still holds
+	if(path.ball.slot != -1 && path.tickRate == playing.tickRate && path.paddleSize == playing.paddleSize &&
+		path.bricks == pilot.bricks && along >= 0 && along < (int)path.states.size() && path.states[along] == FlightHash(ball))
+	{
+		if(path.ticks != -1)
+		{
+			pilot.reused++;
+			if(path.ticks - along > limit)
+			{
+				return -1;
+			}
+			landX = path.landX;
+			pilot.lastLanding = path.ticks > along ? path.states[path.ticks - 1] : path.states[along];
+			return path.ticks - along;
+		}
+		// A path that doesn't land is kept until it runs short, so a landing beyond it is seen well before it comes
+		if((int)path.states.size() - 1 - along >= std::min(limit, AUTOPILOTHORIZON*scale/2))
+		{
+			pilot.reused++;
+			return -1;
+		}
+	}
+
+	PrepareScratch(pilot);
+	GameSelection select(scratch); // The ball is moved in the scratch game, the game being played is selected again on return
+	StartScratchBall(pilot, ball);
+
+	// Start a new path for the ball
+	path.ball = handle;
+	path.start = playing.gameTick;
+	path.tickRate = playing.tickRate;
+	path.paddleSize = playing.paddleSize;
+	path.bricks = pilot.bricks;
+	path.ticks = -1;
+	path.states.clear();
+	path.states.push_back(FlightHash(scratch.balls[0]));
+
+	// Move it as a game update would until it comes down onto the paddle's row
+	pilot.predictions++;
+	while(!Landed(scratch.balls[0], top))
+	{
+		if(ticks == limit)
+		{
+			pilot.steps += ticks;
+			return -1;
+		}
+		AdvanceTimers();
+		SweepBall(0);
+		scratch.tickPhase = (scratch.tickPhase + 1) % scale;
+		ticks++;
+		if(scratch.balls.Count() == 0) // It can't get past the paddle's row, but never follow a ball that has gone
+		{
+			path.ball.slot = -1;
+			pilot.steps += ticks;
+			return -1;
+		}
+		path.states.push_back(FlightHash(scratch.balls[0]));
+	}
+	pilot.steps += ticks;
+	path.ticks = ticks;
+	path.landX = scratch.balls[0].x + (GetBallShape(scratch.balls[0].size).minX + GetBallShape(scratch.balls[0].size).maxX + 1) / 2;
+	landX = path.landX;
+	pilot.lastLanding = path.states[ticks > 0 ? ticks - 1 : 0];
+	return ticks;
+}
+
+void PrepareScratch(Autopilot &pilot) // Bring the scratch game up to date with the selected game, to move a ball in
+{
+	GameState &playing = *game; // The game being played
+	GameState &scratch = pilot.scratch; // The game the ball is moved in
+
+	// Bring the scratch game's bricks up to date, only copying them all when they differ
+	if(memcmp(scratch.brickGrid.rows, playing.brickGrid.rows, sizeof(playing.brickGrid.rows)) != 0 ||
+		memcmp(scratch.brickGrid.grey, playing.brickGrid.grey, sizeof(playing.brickGrid.grey)) != 0 ||
+		memcmp(scratch.brickGrid.explosive, playing.brickGrid.explosive, sizeof(playing.brickGrid.explosive)) != 0)
+	{
+		scratch.brickGrid = playing.brickGrid;
+	}
+
+	// Copy the settings the ball moves by, with the paddle off the board so the ball passes its row
+	scratch.tickRate = playing.tickRate;
+	scratch.tickPhase = playing.tickPhase;
+	scratch.ballModel = playing.ballModel;
+	scratch.broadPhase = playing.broadPhase;
+	scratch.paddleSize = playing.paddleSize;
+	scratch.paddlePos = -TILESIZE*GAMEWIDTH;
+	scratch.numBricks = BGAMEWIDTH*BGAMEHEIGHT + 1; // Knocking out every brick doesn't complete the level
+	scratch.gameTick = playing.gameTick;
+}
+
+void StartScratchBall(Autopilot &pilot, const Ball &ball) // Put a copy of a ball alone in the scratch game, which must be selected
+{
+	if(pilot.timersUsed)
+	{
+		ResetTimers();
+	}
+	ClearEvents();
+	game->balls.Clear();
+	game->balls.Add();
+	game->balls[0] = ball;
+	game->balls[0].noRebound = 0;
+
+	// The fire and explosive powerups wear off part way through as they will in the game
+	pilot.timersUsed = ball.fire > 0 || ball.explosive > 0;
+	if(ball.fire > 0)
+	{
+		ScheduleTimer(TIMER_FIRE, game->balls.Handle(0), ball.fire);
+	}
+	if(ball.explosive > 0)
+	{
+		ScheduleTimer(TIMER_EXPLOSIVE, game->balls.Handle(0), ball.explosive);
+	}
+}
+
+PilotPath &FindPath(Autopilot &pilot, PoolHandle ball) // Returns the path kept for a ball, or the one to replace with it
+{
+	int n; // Counter
+
+	for(n = 0; n < AUTOPILOTPATHS; n++)
+	{
+		if(pilot.paths[n].ball.slot == ball.slot && pilot.paths[n].ball.generation == ball.generation)
+		{
+			return pilot.paths[n];
+		}
+	}
+	n = pilot.nextPath;
+	pilot.nextPath = (pilot.nextPath + 1) % AUTOPILOTPATHS;
+	pilot.paths[n].ball.slot = -1; // Not the ball's path until it has been followed
+	return pilot.paths[n];
+}
+
+void WatchBricks(Autopilot &pilot) // Count a change if the bricks aren't as they were last looked at
+{
+	// Knocking out a brick anywhere can change any ball's path, so every path followed before is out of date
+	if(memcmp(pilot.seenRows, game->brickGrid.rows, sizeof(pilot.seenRows)) != 0 ||
+		memcmp(pilot.seenGrey, game->brickGrid.grey, sizeof(pilot.seenGrey)) != 0 ||
+		memcmp(pilot.seenExplosive, game->brickGrid.explosive, sizeof(pilot.seenExplosive)) != 0)
+	{
+		memcpy(pilot.seenRows, game->brickGrid.rows, sizeof(pilot.seenRows));
+		memcpy(pilot.seenGrey, game->brickGrid.grey, sizeof(pilot.seenGrey));
+		memcpy(pilot.seenExplosive, game->brickGrid.explosive, sizeof(pilot.seenExplosive));
+		pilot.bricks++;
+	}
+}
+
+unsigned int FlightHash(const Ball &ball) // Returns a hash of everything about a ball that changes where it goes
+{
+	unsigned int sum = 2166136261u; // The hash so far
+
+	ChecksumAdd(sum, ball.x);
+	ChecksumAdd(sum, ball.y);
+	ChecksumAdd(sum, ball.subX);
+	ChecksumAdd(sum, ball.subY);
+	ChecksumAdd(sum, ball.speedX);
+	ChecksumAdd(sum, ball.speedY);
+	ChecksumAdd(sum, ball.size);
+	ChecksumAdd(sum, ball.fire);
+	ChecksumAdd(sum, ball.explosive);
+	ChecksumAdd(sum, ball.greyBricks);
+	return sum;
+}
+
+bool Landed(const Ball &ball, int top) // Is the ball coming down onto the paddle's top row
+{
+	return ball.speedY > 0 && ball.y + GetBallShape(ball.size).maxY + 1 >= top;
+}
+
+int LandingBound(int num) // Fewest game updates before ball num could come down onto the paddle's top row
+{
+	const Ball &ball = game->balls[num];
+	int top = GetPaddleProfile(PADDLEPROFILE_DOWN, GetPaddleSize()).top; // The paddle's top row
+	long long distance = top - (ball.y + GetBallShape(ball.size).maxY + 1); // Pixels the ball has to come down
+	long long speed = abs(ball.speedY); // Bricks and borders only turn a ball round, so it never comes down faster than this
+	long long updates; // Whole 20 a second updates it needs
+
+	if(speed == 0)
+	{
+		return AUTOPILOTHORIZON*TickScale(); // A ball that isn't moving up or down never lands
+	}
+	updates = (distance - 1)*SUBPIXELS/speed; // Less a pixel, as it may be most of the way through its pixel already
+	if(updates <= 1)
+	{
+		return 0;
+	}
+	if(updates > AUTOPILOTHORIZON)
+	{
+		return AUTOPILOTHORIZON*TickScale();
+	}
+	return (int)(updates - 1) * TickScale(); // Less an update, as it may be part way through one
+}
+
+int PaddleReach(int ticks) // Most pixels the paddle can move in a number of game updates
+{
+	return (int)((long long)ticks * GetPaddleSpeed() / TickScale());
+}
+
+void PickTarget(Autopilot &pilot) // Aim at the lowest brick of the column with the most bricks left to knock out
+{
+	int bricks[BGAMEWIDTH] = {0}; // Bricks left to knock out in each column, below any grey brick
+	int lowest[BGAMEWIDTH]; // Row of the lowest of them
+	unsigned long long shielded = 0; // Columns with a grey brick below the row looked at, which the ball can't get past
+	unsigned long long row; // Bricks that can be knocked out in a row
+	int x, y; // Counters
+	int best = -1; // The column aimed at
+
+	for(y = BGAMEHEIGHT - 1; y >= 0; y--)
+	{
+		for(row = game->brickGrid.rows[y] & ~game->brickGrid.grey[y] & ~shielded; row; row &= row - 1)
+		{
+			x = LowestBit64(row);
+			if(bricks[x] == 0)
+			{
+				lowest[x] = y;
+			}
+			bricks[x]++;
+		}
+		shielded |= game->brickGrid.grey[y];
+	}
+
+	// Ties go to the column nearest the middle, which the ball reaches with the least rebounding off the borders
+	for(x = 0; x < BGAMEWIDTH; x++)
+	{
+		if(bricks[x] > 0 && (best == -1 || bricks[x] > bricks[best] ||
+			(bricks[x] == bricks[best] && abs(2*x + 1 - BGAMEWIDTH) < abs(2*best + 1 - BGAMEWIDTH))))
+		{
+			best = x;
+		}
+	}
+	pilot.aimBricks = pilot.bricks;
+	pilot.aimMisses = 0;
+	pilot.targetX = best == -1 ? -1 : best*BRICKSIZE + BRICKSIZE/2;
+	pilot.targetY = best == -1 ? -1 : lowest[best]*BRICKSIZE + BRICKSIZE/2;
+}
+
+int AimOffset(Autopilot &pilot, int num, int landX) // Pixels from the paddle's centre to catch ball num of the selected game on as it lands at landX, to send it towards the target
+{
+	// Each way the paddle can send the ball off is tried, following the line it would leave along up to the
+	// target's row, and the steepest that ends up close to the target is taken (or else the closest)
+	int half = TILESIZE + GetPaddleSize()*TILESIZE/2; // Half the paddle's length
+	int limit = half - TILESIZE/2; // Furthest from the centre a ball is caught
+	int rise; // Pixels up from where the ball leaves the paddle to the target's row
+	int offset; // Where on the paddle the ball would be caught
+	int speedX, speedY; // Way the ball would be sent off
+	int miss; // How far from the target it would end up
+	int ticks; // Game updates before it would knock a brick out
+	int best = 0; // Where on the paddle to catch it
+	int bestMiss = -1; // How far from the target that sends it
+	int bestSpeedY = 0; // How fast it goes up
+	int bestTicks = -1; // Game updates before the ball sent off the quickest way knocks a brick out
+	int jitter; // Most pixels either side of it to catch the ball, so the rebounds don't repeat
+	int n; // Counter
+
+	if(pilot.aimBricks != pilot.bricks) // If bricks have been knocked out since the target was picked...
+	{
+		PickTarget(pilot);
+	}
+	else
+	{
+		pilot.aimMisses++;
+	}
+	if(pilot.targetX == -1) // No bricks left to aim at
+	{
+		return RandomBelow(pilot.aim, 2*limit + 1) - limit;
+	}
+
+	// Something in the way can turn the ball back down the same way every time, so the aimed way is only
+	// taken while aiming has been knocking bricks out and moving the ball along it would knock one out too
+	if(pilot.aimMisses < AUTOPILOTAIMMISSES)
+	{
+		rise = GetPaddleProfile(PADDLEPROFILE_DOWN, GetPaddleSize()).top - TILESIZE - pilot.targetY;
+		for(n = 0; n < AimWays(); n++)
+		{
+			AimWay(n, offset, speedX, speedY);
+			miss = abs(FoldX(landX + (long long)rise*speedX/speedY) - pilot.targetX);
+			if(abs(offset) <= limit && BetterAim(miss, speedY, bestMiss, bestSpeedY))
+			{
+				best = offset;
+				bestMiss = miss;
+				bestSpeedY = speedY;
+			}
+		}
+		jitter = game->ballModel == BALLMODEL_SMOOTH ? AUTOPILOTSMOOTHJITTER : (GetPaddleSize() + 2)/2 - AUTOPILOTAIMMARGIN;
+		if(jitter > 0)
+		{
+			best += RandomBelow(pilot.aim, 2*jitter + 1) - jitter;
+		}
+		best = std::max(-limit, std::min(limit, best));
+		if(ShotTicks(pilot, num, landX, best) != -1)
+		{
+			return best;
+		}
+	}
+
+	// Otherwise the way that knocks a brick out soonest is taken, which finds the last few bricks of a level
+	// tucked away where aiming at them straight can't reach
+	for(n = 0; n < AimWays(); n++)
+	{
+		AimWay(n, offset, speedX, speedY);
+		offset = std::max(-limit, std::min(limit, offset));
+		ticks = ShotTicks(pilot, num, landX, offset);
+		if(ticks != -1 && (bestTicks == -1 || ticks < bestTicks))
+		{
+			best = offset;
+			bestTicks = ticks;
+		}
+	}
+	if(bestTicks != -1)
+	{
+		return best;
+	}
+	return RandomBelow(pilot.aim, 2*limit + 1) - limit; // No way does, so catch it anywhere to get it out of its loop
+}
+
+int AimWays() // Number of ways the paddle can send a ball off in the selected game
+{
+	// Any sideways speed in sixteenths from SMOOTHMINANGLE to less than SMOOTHMAXANGLE either way (off the very
+	// end the ball wouldn't be caught), or the paddle is split into eight parts for the original balls
+	return game->ballModel == BALLMODEL_SMOOTH ? 2*(SMOOTHMAXANGLE - SMOOTHMINANGLE) : 8;
+}
+
+void AimWay(int n, int &offset, int &speedX, int &speedY) // Where on the paddle to catch a ball to send it off the nth way, and how fast it goes
+{
+	int size = GetPaddleSize(); // Size of the paddle
+	int half = TILESIZE + size*TILESIZE/2; // Half the paddle's length
+	int angle; // Sideways part of a smooth ball's speed in sixteenths
+
+	if(game->ballModel == BALLMODEL_SMOOTH)
+	{
+		angle = n < SMOOTHMAXANGLE - SMOOTHMINANGLE ? n - SMOOTHMAXANGLE + 1 : n - SMOOTHMAXANGLE + 2*SMOOTHMINANGLE;
+		speedX = SMOOTHBALLSPEED*angle/16;
+		speedY = IntSqrt((long long)SMOOTHBALLSPEED*SMOOTHBALLSPEED - (long long)speedX*speedX);
+		offset = half*angle/SMOOTHMAXANGLE;
+		return;
+	}
+
+	// The parts send the ball off at -4 to -1 and 1 to 4 pixels sideways, caught in the middle of the part
+	speedX = n < 4 ? n - 4 : n - 3;
+	speedY = LEGACYBALLSTEPS - abs(speedX) > 1 ? LEGACYBALLSTEPS - abs(speedX) : 1;
+	offset = n*(size + 2) + (size + 2)/2 - half;
+}
+
+int ShotTicks(Autopilot &pilot, int num, int landX, int offset) // Game updates after ball num of the selected game leaves the paddle, caught at landX offset pixels from the paddle's centre, before it knocks a brick out (-1 = not before it comes down again)
+{
+	GameState &scratch = pilot.scratch; // The game the ball is moved in
+	const Ball &ball = game->balls[num]; // The ball caught
+	int top = GetPaddleProfile(PADDLEPROFILE_DOWN, GetPaddleSize()).top; // The paddle's top row
+	int half = TILESIZE + GetPaddleSize()*TILESIZE/2; // Half the paddle's length
+	int limit = AUTOPILOTHORIZON*TickScale(); // Most game updates to follow it for, each way
+	int ticks = 0; // Game updates moved so far, since it left the paddle once it has
+	int bricks = 0; // Bricks left in the scratch game as the ball left the paddle
+	bool down = false; // Has it come down onto the paddle's row
+	bool released = false; // Has it left the paddle again
+
+	PrepareScratch(pilot);
+	GameSelection select(scratch); // The ball is moved in the scratch game, the game being played is selected again on return
+	StartScratchBall(pilot, ball);
+
+	// The paddle waits where it will catch the ball, so the ball is sent off by the game itself just as it will be
+	scratch.paddlePos = landX - offset - half;
+	pilot.timersUsed = true; // Leaving the paddle starts a timer
+
+	while(ticks < limit)
+	{
+		AdvanceTimers();
+		SweepBall(0);
+		scratch.tickPhase = (scratch.tickPhase + 1) % TickScale();
+		ticks++;
+		if(scratch.balls.Count() == 0) // If it got past the paddle...
+		{
+			return -1;
+		}
+		if(!released)
+		{
+			down = down || Landed(scratch.balls[0], top);
+			if(down && scratch.balls[0].speedY < 0) // If it has rebounded off the paddle...
+			{
+				released = true;
+				bricks = scratch.numBricks;
+				ticks = 0;
+			}
+		}
+		else if(scratch.numBricks < bricks) // If it knocked one out...
+		{
+			return ticks;
+		}
+		else if(Landed(scratch.balls[0], top)) // If it came down again without hitting one...
+		{
+			return -1;
+		}
+	}
+	return -1;
+}
+
+bool BetterAim(int miss, int speedY, int bestMiss, int bestSpeedY) // Is a way of sending the ball off better than the best so far
+{
+	// A shallow rebound takes far longer to get up to the bricks and back, so any way that comes close enough
+	// is as good as any other and the steepest of them wins
+	if(bestMiss == -1)
+	{
+		return true;
+	}
+	if(miss <= AUTOPILOTAIMSLACK && bestMiss <= AUTOPILOTAIMSLACK)
+	{
+		return speedY > bestSpeedY;
+	}
+	return miss < bestMiss;
+}
+
+int FoldX(long long x) // Where a ball's centre heading along a line to x ends up, rebounding off the side borders
+{
+	long long left = 2*TILESIZE; // About the furthest left a ball's centre gets, a border and half a ball in
+	long long width = GAMEWIDTH*TILESIZE - 4*TILESIZE; // Pixels its centre moves across between the borders
+	long long across = (x - left) % (2*width); // Where it is on the way across and back
+
+	if(across < 0)
+	{
+		across += 2*width;
+	}
+	if(across > width) // On the way back
+	{
+		across = 2*width - across;
+	}
+	return (int)(left + across);
+}
@@ -0,0 +1,100 @@
+// Autopilot.h
+// A paddle controller that plays the game by working out where each ball will come down
+// A ball's landing is found by moving a copy of it through a copy of the bricks with the game's own
+//   SweepBall, so it rebounds off the borders and bricks (and knocks them out) exactly as it will in the game,
+//   with the paddle moved out of the way, until it comes down onto the paddle's top row
+// The balls are looked at soonest possible landing first, and once one has been found the paddle can reach,
+//   any ball that couldn't land before it isn't followed through at all
+// The path a ball was followed along is kept as a hash of its state at each game update, so while the ball
+//   stays on that path and no brick has changed, the landing is already known and it isn't followed again
+// Each ball is caught on the part of the paddle that sends it off towards the lowest brick of the column with
+//   the most bricks left, reflecting the line off the side borders, so the last bricks of a level get hit
+// The aimed way is checked by moving the ball along it in the scratch game, and if it wouldn't knock a brick out
+//   before coming down again every way is tried and the one that knocks one out soonest is taken instead
+
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+#pragma once
+
+// Include the game state header for the game being played and the copy the balls are moved in
+#include "gamestate.h"
+
+// Include standard library
+#include <vector>
+
+// Declare and define constants
+const int AUTOPILOTHORIZON = 200; // Most 20 a second updates a ball is followed before giving up on it landing
+const int AUTOPILOTPATHS = 16; // Number of balls whose paths are kept
+const int AUTOPILOTAIMMARGIN = 2; // Pixels kept between where a ball is caught and the ends of the part of the paddle that sends it the way it's aimed
+const int AUTOPILOTAIMSLACK = BRICKSIZE; // Pixels either side of the target a ball sent off steeply may go instead
+const int AUTOPILOTAIMMISSES = 2; // Balls aimed without knocking anything out before the aimed way is no longer tried first
+const int AUTOPILOTSMOOTHJITTER = 2; // Most pixels a smooth ball is caught either side of where it's aimed
+
+// Structure for a ball waiting to be followed
+struct PilotBall{
+	int ball; // The ball in the game
+	int bound; // Fewest game updates it could land in
+};
+
+// Structure for the path a ball was followed along
+struct PilotPath{
+	PoolHandle ball; // The ball followed (slot -1 = not in use)
+	int start; // Game tick it was followed from
+	int tickRate; // Game updates a second it was followed at
+	int paddleSize; // Size of the paddle it was followed down to
+	int bricks; // Number of times the bricks had changed when it was followed
+	int ticks; // Game updates before it lands (-1 = it doesn't in the path)
+	int landX; // Where the centre of the ball lands
+	std::vector<unsigned int> states; // Hash of the ball at the start of each game update along the path
+};
+
+// Structure for the autopilot of a game
+struct Autopilot{
+	GameState scratch; // The game the balls are followed in, holding a copy of the bricks and one ball
+	bool timersUsed; // Did the last ball followed leave events in the scratch game's timer wheel
+	std::vector<PilotBall> order; // The balls in flight, soonest possible landing first
+	PilotPath paths[AUTOPILOTPATHS]; // The paths of the balls followed most recently
+	int nextPath; // The path to be replaced next
+	unsigned long long seenRows[BGAMEHEIGHT+1]; // The bricks as they were when last looked at
+	unsigned long long seenGrey[BGAMEHEIGHT+1]; // The grey bricks as they were
+	unsigned long long seenExplosive[BGAMEHEIGHT+1]; // The explosive bricks as they were
+	int bricks; // Number of times the bricks have been seen to change
+	RandomStream aim; // Picks where within the part of the paddle aimed for to catch each ball, so the rebounds don't repeat
+	int aimOffset; // Pixels from the paddle's centre the ball is caught on
+	int aimBricks; // Number of times the bricks had changed when the target was picked (-1 = none picked)
+	int aimMisses; // Balls aimed at the target since a brick was last knocked out
+	int targetX; // Centre of the brick aimed at (-1 = no bricks left)
+	int targetY; // Its centre down the board
+	unsigned int lastLanding; // Hash of the ball last found a landing for, as it starts the game update it lands in
+	PoolHandle landingBall; // The ball being caught
+	int landingTicks; // Game updates before it lands (-1 = none being caught)
+	int landingX; // Where its centre lands
+	unsigned int landingFrom; // Hash of it as it starts the game update it lands in
+
+	// What the predictions cost
+	long long calls; // Number of game updates the autopilot has worked out the input for
+	long long predictions; // Number of balls followed to their landing
+	long long reused; // Number of landings found from a path already followed
+	long long steps; // Number of game updates the followed balls were moved
+};
+
+void ResetAutopilot(Autopilot &pilot, unsigned long long seed); // Start the autopilot afresh, seed picks where it catches the balls
+TickInput AutopilotInput(Autopilot &pilot); // Work out the input for the next game update of the selected game
+int PredictLanding(Autopilot &pilot, int num, int limit, int &landX); // Game updates before ball num of the selected game comes down onto the paddle's top row (-1 = not within limit), landX is where its centre is
+void PrepareScratch(Autopilot &pilot); // Bring the scratch game up to date with the selected game, to move a ball in
+void StartScratchBall(Autopilot &pilot, const Ball &ball); // Put a copy of a ball alone in the scratch game, which must be selected
+PilotPath &FindPath(Autopilot &pilot, PoolHandle ball); // Returns the path kept for a ball, or the one to replace with it
+void WatchBricks(Autopilot &pilot); // Count a change if the bricks aren't as they were last looked at
+unsigned int FlightHash(const Ball &ball); // Returns a hash of everything about a ball that changes where it goes
+bool Landed(const Ball &ball, int top); // Is the ball coming down onto the paddle's top row
+int LandingBound(int num); // Fewest game updates before ball num could come down onto the paddle's top row
+int PaddleReach(int ticks); // Most pixels the paddle can move in a number of game updates
+void PickTarget(Autopilot &pilot); // Aim at the lowest brick of the column with the most bricks left to knock out
+int AimOffset(Autopilot &pilot, int num, int landX); // Pixels from the paddle's centre to catch ball num of the selected game on as it lands at landX, to send it towards the target
+int AimWays(); // Number of ways the paddle can send a ball off in the selected game
+void AimWay(int n, int &offset, int &speedX, int &speedY); // Where on the paddle to catch a ball to send it off the nth way, and how fast it goes
+int ShotTicks(Autopilot &pilot, int num, int landX, int offset); // Game updates after ball num of the selected game leaves the paddle, caught at landX offset pixels from the paddle's centre, before it knocks a brick out (-1 = not before it comes down again)
+bool BetterAim(int miss, int speedY, int bestMiss, int bestSpeedY); // Is a way of sending the ball off better than the best so far
+int FoldX(long long x); // Where a ball's centre heading along a line to x ends up, rebounding off the side borders
+
+#endif
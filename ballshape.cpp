@@ -0,0 +1,210 @@
+// BallShape.cpp
+// The pixel shapes of the seven ball sizes, stored as bit masks
+
+// Include the ball shape header
+#include "ballshape.h"
+#include "bitops.h"
+
+BallShape ballShapes[8]; // Shapes for ball sizes 1 to 7, shape 0 is the empty shape for no ball
+
+bool BallPixel(int size, int x, int y) // Returns whether pixel x,y is part of a ball of the given size
+{
+	switch(size)
+	// false = pixel absent
+	// true = pixel present
+	{
+	case 1: // 4x4 block centred on a 16x16 grid
+		{
+			return (x > 5 && x < 10 && y > 5 && y < 10);
+		}
+	case 2: // 6x6 block centred on a  16x16 grid
+		{
+			if(x > 4 && x < 11 && y > 4 && y < 11)
+			{
+				 // With a 1x1 block missing from the corners
+				return !((x == 5 || x == 10) && (y == 5 || y == 10));
+			}
+			return false;
+		}
+	case 3: // 8x8 block on a 16x16 grid
+		{
+			if(x > 3 && x < 12 && y > 3 && y < 12)
+			{
+				// With a 2x2 block missing from the corners
+				return !((x == 4 || x == 5 || x == 10 || x == 11) &&
+					(y == 4 || y == 5 || y == 10 || y == 11) &&
+					// With the exception of the inner 1x1 of the 2x2 block
+					!((x == 5 || x == 10) && (y == 5 || y == 10)));
+			}
+			return false;
+		}
+	case 4:// 10x10 block on a 16x16 grid
+		{
+			if(x > 2 && x < 13 && y > 2 && y < 13)
+			{
+				// With a 3x3 block missing from the corner
+				return !(( (x >= 3 && x <= 5) || (x >= 10 && x <= 12) ) &&
+					( (y >= 3 && y <= 5) || (y >= 10 && y <= 12) ) &&
+					// With exception of the inner 2x2 block of the 3x3 block
+					!((x == 4 || x == 5 || x == 10 || x == 11) &&
+					(y == 4 || y == 5 || y == 10 || y == 11) &&
+					// With a double exception of the outer 1x1 block of the 2x2 block
+					!((x == 4 || x == 11) && (y == 4 || y == 11))) );
+			}
+			return false;
+		}
+	case 5:// 12x12 block on a 16x16 grid
+		{
+			if(x > 1 && x < 14 && y > 1 && y < 14)
+			{
+				// With a 4x4 block missing from the corner
+				return !(( (x >= 2 && x <= 5) || (x >= 10 && x <= 13) ) &&
+					( (y >= 2 && y <= 5) || (y >= 10 && y <= 13) ) &&
+					// With exception of the inner 3x3 block of the 4x4 block
+					!(( (x >= 3 && x == 5) || (x >= 10 && x <= 12) ) &&
+					( (y >= 3 && y == 5) || (y >= 10 && y <= 12) ) &&
+					// With a double exception of the outer 1x1 block of the 3x3 block
+					!((x == 3 || x == 12) && (y == 3 || y == 12))) );
+			}
+			return false;
+		}
+	case 6:// 14x14 block on a 16x16 grid
+		{
+			if(x > 0 && x < 15 && y > 0 && y < 15)
+			{
+				// With a 5x5 block missing from the corner
+				return !(( (x >= 1 && x <= 5) || (x >= 10 && x <= 14) ) &&
+					( (y >= 1 && y <= 5) || (y >= 10 && y <= 14) ) &&
+					// With exception of the inner 4x4 block of the 5x5 block
+					!(( (x >= 2 && x <= 5) || (x >= 10 && x <= 13) ) &&
+					( (y >= 2 && y <= 5) || (y >= 10 && y <= 13) ) &&
+					// With a double exception of the outer 2x2 block of the 4x4 block
+					!((x == 2 || x == 3 || x == 12 || x == 13) &&
+					(y == 2 || y == 3 || y == 12 || y == 13) &&
+					// With a triple exception of the inner 1x1 block of the 2x2 block
+					!((x == 3 || x == 12) && (y == 3 || y == 12))) ) );
+			}
+			return false;
+		}
+	case 7:// Fill a 16x16 grid
+		{
+			// With a 6x6 block missing from the corners
+			return !(( (x >= 0 && x <= 5) || (x >= 10 || x <= 15) ) &&
+				( (y >= 0 && y <= 5) || (y >= 10 || y <= 15) ) &&
+				// With an exception of the inner 5x5 block of the 6x6 blocks
+				!(( (x >= 1 && x <= 5) || (x >= 10 && x <= 14) ) &&
+				( (y >= 1 && y <= 5) || (y >= 10 && y <= 14) ) &&
+				// With a double exception of the outer 3x3 block of the 5x5 blocks
+				!(( (x >= 1 && x <= 3) || (x >= 12 && x <= 14) ) &&
+				( (y >= 1 && y <= 3) || (y >= 12 && y <= 14) ) &&
+				// With a triple exception of the inner 2x2 block of the 3x3 blocks
+				!((x == 2 || x == 3 || x == 12 || x == 13) &&
+				(y == 2 || y == 3 || y == 12 || y == 13) &&
+				// With a quadruple exception of the outer 1x1 block of the 2x2 blocks
+				!((x == 2 || x == 13) && (y == 2 || y == 13)) ))));
+		}
+	}
+	return false; // No ball, blank 16x16 grid
+}
+
+void BuildBallShapes() // Build the shape masks and edges for every ball size
+{
+	int size, x, y; // Counters
+
+	for(size = 0; size < 8; size++)
+	{
+		BallShape &shape = ballShapes[size];
+
+		for(y = 0; y < 16; y++)
+		{
+			shape.rows[y] = 0;
+			shape.columns[y] = 0;
+		}
+
+		// Pack the pixels into the row and column masks
+		for(x = 0; x < 16; x++)
+		{
+			for(y = 0; y < 16; y++)
+			{
+				if(BallPixel(size, x, y))
+				{
+					shape.rows[y] |= (unsigned short)(1 << x);
+					shape.columns[x] |= (unsigned short)(1 << y);
+				}
+			}
+		}
+
+		// Find the edge pixels of each row and column
+		shape.minX = 16;
+		shape.maxX = -1;
+		shape.minY = 16;
+		shape.maxY = -1;
+		shape.crossRight = 0;
+		shape.crossLeft = 0;
+		shape.crossDown = 0;
+		shape.crossUp = 0;
+		for(y = 0; y < 16; y++)
+		{
+			shape.left[y] = -1;
+			shape.right[y] = -1;
+			shape.top[y] = -1;
+			shape.bottom[y] = -1;
+			for(x = 0; x < 16; x++)
+			{
+				if(shape.rows[y] & (1 << x))
+				{
+					if(shape.left[y] == -1)
+					{
+						shape.left[y] = (signed char)x;
+					}
+					shape.right[y] = (signed char)x;
+				}
+				if(shape.columns[y] & (1 << x))
+				{
+					if(shape.top[y] == -1)
+					{
+						shape.top[y] = (signed char)x;
+					}
+					shape.bottom[y] = (signed char)x;
+				}
+			}
+
+			// Grow the bounding box and mark where the edges cross brick boundaries
+			if(shape.left[y] != -1)
+			{
+				shape.minX = shape.left[y] < shape.minX ? shape.left[y] : shape.minX;
+				shape.maxX = shape.right[y] > shape.maxX ? shape.right[y] : shape.maxX;
+				shape.crossRight |= (unsigned short)(1 << (15 - shape.right[y]));
+				shape.crossLeft |= (unsigned short)(1 << shape.left[y]);
+			}
+			if(shape.top[y] != -1)
+			{
+				shape.minY = shape.top[y] < shape.minY ? shape.top[y] : shape.minY;
+				shape.maxY = shape.bottom[y] > shape.maxY ? shape.bottom[y] : shape.maxY;
+				shape.crossDown |= (unsigned short)(1 << (15 - shape.bottom[y]));
+				shape.crossUp |= (unsigned short)(1 << shape.top[y]);
+			}
+		}
+	}
+}
+
+const BallShape &GetBallShape(int size) // Returns the shape for the given ball size
+{
+	if(size < 1 || size > 7) // If there is no ball...
+	{
+		return ballShapes[0]; // Return the empty shape
+	}
+	return ballShapes[size];
+}
+
+int StepsToCrossing(unsigned int crossMask, int start) // Number of steps from start before one that crosses into the next brick
+{
+	// Rotate the mask so bit k is the position k steps ahead
+	unsigned int ahead = ((crossMask >> start) | (crossMask << (16 - start))) & 0xFFFF;
+
+	if(!ahead) // If the ball never crosses a brick boundary...
+	{
+		return 1 << 30;
+	}
+	return LowestBit(ahead);
+}
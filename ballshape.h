@@ -0,0 +1,29 @@
+// BallShape.h
+// The pixel shapes of the seven ball sizes, stored as bit masks
+// The shapes are built once and shared by every ball, a ball just looks its shape up by size
+
+#ifndef BALLSHAPE_H
+#define BALLSHAPE_H
+#pragma once
+
+// Structure for the pixels of one ball size on a 16x16 grid
+struct BallShape{
+	unsigned short rows[16]; // Bit x of rows[y] is set if pixel x,y is part of the ball
+	unsigned short columns[16]; // Bit y of columns[x] is set if pixel x,y is part of the ball
+	signed char left[16]; // Left most pixel of each row (-1 = empty row)
+	signed char right[16]; // Right most pixel of each row (-1 = empty row)
+	signed char top[16]; // Top most pixel of each column (-1 = empty column)
+	signed char bottom[16]; // Bottom most pixel of each column (-1 = empty column)
+	int minX, maxX, minY, maxY; // Bounding box of the ball's pixels
+	// Positions (mod 16) where one more step would take a leading edge pixel into the next brick
+	// Right and down are indexed by position & 15, left and up by (-position) & 15
+	unsigned short crossRight, crossLeft, crossDown, crossUp;
+};
+
+extern BallShape ballShapes[8]; // Shapes for ball sizes 1 to 7, shape 0 is the empty shape for no ball
+
+void BuildBallShapes(); // Build the shape masks and edges for every ball size
+const BallShape &GetBallShape(int size); // Returns the shape for the given ball size (no ball gives the empty shape)
+int StepsToCrossing(unsigned int crossMask, int start); // Number of steps from start before one that crosses into the next brick
+
+#endif
@@ -0,0 +1,44 @@
+// BitOps.h
+// Small bit scanning helpers used by the game's bit masks
+// Visual C++ has no __builtin functions, so it uses its own intrinsics instead
+
+#ifndef BITOPS_H
+#define BITOPS_H
+#pragma once
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+inline int LowestBit(unsigned int mask) // Index of the lowest set bit (mask must not be 0)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (int)index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+inline int LowestBit64(unsigned long long mask) // Index of the lowest set bit of a 64 bit mask, such as a row of bricks (mask must not be 0)
+{
+	if((unsigned int)mask) // Split in two so 32 bit builds work the same
+	{
+		return LowestBit((unsigned int)mask);
+	}
+	return 32 + LowestBit((unsigned int)(mask >> 32));
+}
+
+inline int HighestBit(unsigned int mask) // Index of the highest set bit (mask must not be 0)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse(&index, mask);
+	return (int)index;
+#else
+	return 31 - __builtin_clz(mask);
+#endif
+}
+
+#endif
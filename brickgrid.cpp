@@ -0,0 +1,235 @@
+// BrickGrid.cpp
+// The bricks of the current level
+
+// Include the brick grid header
+#include "brickgrid.h"
+
+// Include the bit scanning helpers
+#include "bitops.h"
+
+// Include the game state header for the bricks of the game being run
+#include "gamestate.h"
+
+void ClearBricks() // Remove every brick from the board
+{
+	int x, y; // Counters
+
+	for(y = 0; y <= BGAMEHEIGHT; y++)
+	{
+		game->brickGrid.rows[y] = 0;
+		game->brickGrid.grey[y] = 0;
+		game->brickGrid.explosive[y] = 0;
+		for(x = 0; x < BGAMEWIDTH; x++)
+		{
+			game->brickGrid.style[y][x] = 0;
+			game->brickGrid.colour[y][x] = 0;
+			game->brickGrid.powerup[y][x] = 0;
+		}
+	}
+	for(x = 0; x < BGAMEWIDTH; x++)
+	{
+		game->brickGrid.columns[x] = 0;
+	}
+}
+
+void SetBrick(int x, int y, int style, int colour) // Place a brick at x,y
+{
+	if(x < 0 || x >= BGAMEWIDTH || y < 0 || y >= BGAMEHEIGHT) // Bricks can't go off the board or in the empty row
+	{
+		return;
+	}
+
+	game->brickGrid.style[y][x] = (unsigned char)style;
+	game->brickGrid.colour[y][x] = (unsigned char)colour;
+
+	if(style || colour) // If there is a brick...
+	{
+		game->brickGrid.rows[y] |= 1ULL << x;
+		game->brickGrid.columns[x] |= 1u << y;
+	}
+	else
+	{
+		game->brickGrid.rows[y] &= ~(1ULL << x);
+		game->brickGrid.columns[x] &= ~(1u << y);
+		game->brickGrid.explosive[y] &= ~(1ULL << x); // An empty cell can't explode
+	}
+	if(colour == 1) // Grey bricks are kept apart as only the biggest balls knock them out
+	{
+		game->brickGrid.grey[y] |= 1ULL << x;
+	}
+	else
+	{
+		game->brickGrid.grey[y] &= ~(1ULL << x);
+	}
+}
+
+void SetBrickExplosive(int x, int y, bool explosive) // Make the brick at x,y explode when knocked out
+{
+	if(x < 0 || x >= BGAMEWIDTH || y < 0 || y >= BGAMEHEIGHT)
+	{
+		return;
+	}
+	if(explosive && BrickAt(x, y)) // Only a brick can explode
+	{
+		game->brickGrid.explosive[y] |= 1ULL << x;
+	}
+	else
+	{
+		game->brickGrid.explosive[y] &= ~(1ULL << x);
+	}
+}
+
+void SetBrickPowerup(int x, int y, int powerup) // Give the brick at x,y a powerup coin
+{
+	if(x < 0 || x >= BGAMEWIDTH || y < 0 || y >= BGAMEHEIGHT)
+	{
+		return;
+	}
+	game->brickGrid.powerup[y][x] = (unsigned char)powerup;
+}
+
+void RemoveBrick(int x, int y) // Knock out the brick at x,y
+{
+	SetBrick(x, y, 0, 0);
+}
+
+void RemoveBricks(int y, unsigned long long mask) // Knock out the bricks in row y with a bit set in mask
+{
+	int x; // Column of a brick being knocked out
+
+	if(y < 0 || y >= BGAMEHEIGHT)
+	{
+		return;
+	}
+	mask &= game->brickGrid.rows[y]; // Only the bricks that are there
+	game->brickGrid.rows[y] &= ~mask; // Clear the whole row at once
+	game->brickGrid.grey[y] &= ~mask;
+	game->brickGrid.explosive[y] &= ~mask;
+	while(mask) // Then the columns and the details of each brick
+	{
+		x = LowestBit64(mask);
+		mask &= mask - 1;
+		game->brickGrid.columns[x] &= ~(1u << y);
+		game->brickGrid.style[y][x] = 0;
+		game->brickGrid.colour[y][x] = 0;
+	}
+}
+
+int TakeBrickPowerup(int x, int y) // Returns the powerup coin of the brick at x,y and removes it from the brick
+{
+	int powerup = BrickPowerup(x, y);
+
+	if(powerup)
+	{
+		game->brickGrid.powerup[y][x] = 0;
+	}
+	return powerup;
+}
+
+bool BrickAt(int x, int y) // Is there a brick at x,y
+{
+	if(x < 0 || x >= BGAMEWIDTH || y < 0 || y > BGAMEHEIGHT)
+	{
+		return false;
+	}
+	return (game->brickGrid.rows[y] >> x) & 1;
+}
+
+int BrickStyle(int x, int y) // Returns the style of the brick at x,y
+{
+	if(x < 0 || x >= BGAMEWIDTH || y < 0 || y > BGAMEHEIGHT)
+	{
+		return 0;
+	}
+	return game->brickGrid.style[y][x];
+}
+
+int BrickColour(int x, int y) // Returns the colour of the brick at x,y
+{
+	if(x < 0 || x >= BGAMEWIDTH || y < 0 || y > BGAMEHEIGHT)
+	{
+		return 0;
+	}
+	return game->brickGrid.colour[y][x];
+}
+
+int BrickPowerup(int x, int y) // Returns the powerup of the brick at x,y
+{
+	if(x < 0 || x >= BGAMEWIDTH || y < 0 || y > BGAMEHEIGHT)
+	{
+		return 0;
+	}
+	return game->brickGrid.powerup[y][x];
+}
+
+bool BrickExplosive(int x, int y) // Does the brick at x,y explode when knocked out
+{
+	if(x < 0 || x >= BGAMEWIDTH || y < 0 || y > BGAMEHEIGHT)
+	{
+		return false;
+	}
+	return (game->brickGrid.explosive[y] >> x) & 1;
+}
+
+unsigned long long BrickRow(int y) // Returns the bricks in row y as bits
+{
+	if(y < 0 || y > BGAMEHEIGHT)
+	{
+		return 0;
+	}
+	return game->brickGrid.rows[y];
+}
+
+unsigned int BrickColumn(int x) // Returns the bricks in column x as bits
+{
+	if(x < 0 || x >= BGAMEWIDTH)
+	{
+		return 0;
+	}
+	return game->brickGrid.columns[x];
+}
+
+unsigned long long GreyRow(int y) // Returns the grey bricks in row y as bits
+{
+	if(y < 0 || y > BGAMEHEIGHT)
+	{
+		return 0;
+	}
+	return game->brickGrid.grey[y];
+}
+
+int FirstBrickAbove(int x, int y) // Returns the row of the nearest brick at or above row y in column x
+{
+	unsigned int above; // The bricks in the column from row 0 to row y
+
+	if(y < 0)
+	{
+		return -1;
+	}
+	above = BrickColumn(x);
+	if(y < 31) // Keep only rows 0 to y
+	{
+		above &= (2u << y) - 1;
+	}
+	if(!above)
+	{
+		return -1;
+	}
+	return HighestBit(above);
+}
+
+unsigned int BrickNeighbourhood(int x, int y) // Returns the bricks in the 5x5 square around x,y
+{
+	unsigned int mask = 0; // The bricks found
+	unsigned int column; // Bricks in the 5 rows of one column
+	int n; // Counter
+
+	for(n = -2; n <= 2; n++)
+	{
+		// Line the column up so rows y-2 to y+2 are bits 0 to 4
+		column = BrickColumn(x + n);
+		column = y >= 2 ? column >> (y - 2) : column << (2 - y);
+		mask |= (column & 31) << ((n + 2) * 5);
+	}
+	return mask;
+}
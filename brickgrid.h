@@ -0,0 +1,44 @@
+// BrickGrid.h
+// The bricks of the current level
+// Which cells hold a brick is kept as bit boards (one word per row and per column) so whole rows,
+// columns and neighbourhoods can be tested at once, with the brick details kept in byte planes beside them
+
+#ifndef BRICKGRID_H
+#define BRICKGRID_H
+#pragma once
+
+// Include the game core header for the board size
+#include "gamecore.h"
+
+// Structure for the bricks on the board
+// The extra row at the bottom is always empty, so checks just below the board find nothing
+struct BrickGrid{
+	unsigned long long rows[BGAMEHEIGHT+1]; // Bit x of rows[y] is set if there is a brick at x,y
+	unsigned int columns[BGAMEWIDTH]; // Bit y of columns[x] is set if there is a brick at x,y
+	unsigned long long grey[BGAMEHEIGHT+1]; // Bit x of grey[y] is set if there is a grey brick at x,y
+	unsigned long long explosive[BGAMEHEIGHT+1]; // Bit x of explosive[y] is set if the brick at x,y explodes when knocked out
+	unsigned char style[BGAMEHEIGHT+1][BGAMEWIDTH]; // The style of each brick (0 = no brick)
+	unsigned char colour[BGAMEHEIGHT+1][BGAMEWIDTH]; // The colour of each brick (1 = grey)
+	unsigned char powerup[BGAMEHEIGHT+1][BGAMEWIDTH]; // The powerup coin held by each brick (0 = none)
+};
+
+void ClearBricks(); // Remove every brick from the board
+void SetBrick(int x, int y, int style, int colour); // Place a brick at x,y (style and colour 0 removes it)
+void SetBrickPowerup(int x, int y, int powerup); // Give the brick at x,y a powerup coin
+void RemoveBrick(int x, int y); // Knock out the brick at x,y, leaving any powerup coin for TakeBrickPowerup
+int TakeBrickPowerup(int x, int y); // Returns the powerup coin of the brick at x,y and removes it from the brick
+void SetBrickExplosive(int x, int y, bool explosive); // Make the brick at x,y explode when knocked out
+void RemoveBricks(int y, unsigned long long mask); // Knock out the bricks in row y with a bit set in mask, leaving any powerup coins
+
+bool BrickAt(int x, int y); // Is there a brick at x,y (false off the board)
+int BrickStyle(int x, int y); // Returns the style of the brick at x,y (0 off the board)
+int BrickColour(int x, int y); // Returns the colour of the brick at x,y (0 off the board)
+int BrickPowerup(int x, int y); // Returns the powerup of the brick at x,y (0 off the board)
+bool BrickExplosive(int x, int y); // Does the brick at x,y explode when knocked out (false off the board)
+unsigned long long BrickRow(int y); // Returns the bricks in row y as bits (0 off the board)
+unsigned int BrickColumn(int x); // Returns the bricks in column x as bits (0 off the board)
+unsigned long long GreyRow(int y); // Returns the grey bricks in row y as bits (0 off the board)
+int FirstBrickAbove(int x, int y); // Returns the row of the nearest brick at or above row y in column x (-1 = none)
+unsigned int BrickNeighbourhood(int x, int y); // Returns the bricks in the 5x5 square around x,y, bit (n+2)*5+(m+2) for brick x+n,y+m
+
+#endif
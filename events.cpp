@@ -0,0 +1,25 @@
+// Events.cpp
+// The things that happen during a game update, kept in a buffer for the sound, the score and the front end
+
+// Include the events header
+#include "events.h"
+
+// Include the game state header for the events of the game being run
+#include "gamestate.h"
+
+void PostEvent(int type, int detail, int x, int y, int value) // Note down an event for after the game update
+{
+	GameEvent event; // The new event
+
+	event.type = (unsigned char)type;
+	event.detail = (unsigned char)detail;
+	event.x = (short)x;
+	event.y = (short)y;
+	event.value = value;
+	game->gameEvents.push_back(event); // Keeps its room between updates, so this rarely allocates
+}
+
+void ClearEvents() // Drop the events noted down
+{
+	game->gameEvents.clear();
+}
@@ -0,0 +1,51 @@
+// Events.h
+// The things that happen during a game update, kept in a buffer for the sound, the score and the front end
+// The collision code only notes down what happened, in a few bytes, and carries on moving things
+// Once the update has moved everything, DispatchGameEvents (gamecore.h) goes through the buffer in one go,
+//   adding up the score, playing the sounds and handing the events to the front end
+
+#ifndef EVENTS_H
+#define EVENTS_H
+#pragma once
+
+// Include standard library
+#include <vector>
+
+// The kinds of event
+const int EVENT_BRICKDESTROYED = 0; // A brick was knocked out at x,y, detail is the cause and value the points scored
+const int EVENT_REBOUND = 1; // A ball bounced off something at x,y, detail is what it bounced off
+const int EVENT_POWERUPSPAWNED = 2; // A powerup coin was added at x,y, value is its powerup
+const int EVENT_COINCOLLECTED = 3; // The paddle caught a powerup coin at x,y, value is its powerup
+const int EVENT_POWERUPGAINED = 4; // A powerup was applied, value is the powerup
+const int EVENT_LIFELOST = 5; // The last ball was lost and a life was used
+const int EVENT_GAMELOST = 6; // The last ball was lost with no lives left
+const int EVENT_LASERFIRED = 7; // The lasers fired
+const int EVENT_CHAINREACTION = 8; // Explosive bricks went off, value is the number of explosions
+const int EVENT_LEVELCLEARED = 9; // The last brick of the level was knocked out, value is the level
+const int EVENT_LEVELSTARTED = 10; // A level was loaded and the ball reset, value is the level, detail is 1 if it happened during play
+const int EVENT_GREYLOOPBROKEN = 11; // A small ball that kept rebounding off grey bricks knocked one out at x,y, value is the rebounds in a row
+const int NUM_EVENTS = 12; // Number of kinds of event
+
+// What knocked a brick out
+const int CAUSE_BALL = 0; // A ball hit it
+const int CAUSE_EXPLOSION = 1; // An explosion caught it
+const int CAUSE_LASER = 2; // A laser bullet hit it
+
+// What a ball bounced off
+const int REBOUND_BORDER = 0; // The edge of the board
+const int REBOUND_PADDLE = 1; // The paddle
+const int REBOUND_BRICK = 2; // A brick it couldn't knock out
+
+// Structure for an event
+struct GameEvent{
+	unsigned char type; // The kind of event
+	unsigned char detail; // More about it (the cause of a knocked out brick, what a ball bounced off...)
+	short x; // Where it happened on the board, in pixels
+	short y;
+	int value; // How much (points scored, the powerup, the level...)
+};
+
+void PostEvent(int type, int detail, int x, int y, int value); // Note down an event for after the game update
+void ClearEvents(); // Drop the events noted down
+
+#endif
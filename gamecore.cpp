@@ -0,0 +1,2949 @@
+// GameCore.cpp
+// The game simulation for the brick knockout game
+
+// Include the game core header
+#include "gamecore.h"
+
+// Include the ball shapes, brick grid and bit scanning helpers
+#include "ballshape.h"
+#include "brickgrid.h"
+#include "profiles.h"
+#include "bitops.h"
+#include "gamestate.h"
+
+// Include standard library
+#include <stdlib.h>
+#include <assert.h>
+
+// Include file input/output functions
+#include <stdio.h>
+#include <sstream>
+
+// Game variables
+GAMETHREADLOCAL GameState *game = NULL; // The game the calling thread is working on
+
+// Shared game data, loaded once by InitGame
+unsigned char explosionStencils[8][5]; // Bit n+2 of explosionStencils[size][m+2] is set if an explosion of that size knocks out the brick n across and m down
+int maxLevel = 1; // The humber of levels (maps)
+unsigned int levelPackHash = 0; // Hash of the levels file, so a replay can tell if the levels have changed
+std::vector<PackLevel> levelPack; // The levels of the levels file, in the order they are in the file
+int brickStyles = 0; // The number of brick styles
+int coinMap[8][16][16]; // The different pixel layouts for powerup coins
+
+// Sound file constants
+const std::string SOUND_BRICKKO = "BrickKO.WAV"; // Sound file when the ball knocks out a brick
+const std::string SOUND_BRICKREBOUND = "BrickRebound.WAV"; // Sound file when the ball rebounds off an indestructable brick
+const std::string SOUND_BORDERREBOUND = "BorderRebound.WAV"; // Sound file when the ball rebounds off a border
+const std::string SOUND_PADDLEREBOUND = "PaddleRebound.WAV"; // Sound file when the ball rebounds off the paddle
+const std::string SOUND_LOSELIFE = "LoseLife.WAV"; // Sound file when a life is lost
+const std::string SOUND_GAMEOVER = "GameOver.WAV"; // Sound file when the game is lost
+const std::string SOUND_COIN = "Coin"; // Base sound file name when a coin is collected
+const std::string SOUND_PADDLESIZEINC = "PaddleSizeInc.WAV"; // Sound file when paddle size increase is gained
+const std::string SOUND_PADDLESIZEDEC = "PaddleSizeDec.WAV"; // Sound file when paddle size decrease is gained
+const std::string SOUND_PADDLESPEEDINC = "PaddleSpeedInc.WAV"; // Sound file when paddle speed increase is gained
+const std::string SOUND_PADDLESPEEDDEC = "PaddleSpeedDec.WAV"; // Sound file when paddle speed decrease is gained
+const std::string SOUND_BALLSIZEINC = "BallSizeInc.WAV"; // Sound file when ball size increase is gained
+const std::string SOUND_BALLSIZEDEC = "BallSizeDec.WAV"; // Sound file when ball size decrease is gained
+const std::string SOUND_EXTRABALL = "ExtraBall.WAV"; // Sound file when an extra ball is gained
+const std::string SOUND_MAGNETISM = "Magnetism.WAV"; // Sound file when magnetism is gained
+const std::string SOUND_EXTRALIFE = "ExtraLife.WAV"; // Sound file when an extra life is gained
+const std::string SOUND_FIREBALL = "Fireball.WAV"; // Sound file when fireball is gained
+const std::string SOUND_GUNS = "Laser.WAV"; // Sound file when laser guns are gained
+const std::string SOUND_EXPLOSIVE = "Explosive.WAV"; // Sound file when explosive ball is gained
+const std::string SOUND_LASERFIRE = "LaserFire.WAV"; // Sound file when laser gun is fired
+
+void InitGame() // Load the game data shared by every game
+{
+	BuildBallShapes(); // Build the pixel masks for each ball size
+	BuildPaddleProfiles(); // Build the contact profiles for each paddle size
+	BuildExplosionStencils(); // Split the explosion patterns into rows of bricks
+	LoadCoinMap(); // Load in the pixel maps for the powerup coins
+	LoadLevelPack(); // Read the levels, the maximum number of levels and the brick styles from the levels.txt file
+}
+
+void SelectGame(GameState &state) // Make the game functions on this thread work on the given game
+{
+	game = &state;
+}
+
+void SetupGame(GameState &state, unsigned long long seed) // Set up a new game with the first board, paused, from the given seed, and select it
+{
+	int n; // Counter
+
+	SelectGame(state);
+	SeedGame(seed); // Before the first level is built
+
+	// Reset the paddle
+	game->paddleSize = INITPADDLESIZE;
+	game->paddlePos = 279;
+	game->lastPaddlePos = game->paddlePos;
+	game->paddleSpeed = INITPADDLESPEED;
+	game->paddleDirection = 0;
+
+	// Reset the powerups and progress
+	game->magnetic = 0;
+	game->laser = 0;
+	game->laserPierce = 0;
+	game->livesRemaining = 4;
+	game->level = 1;
+	game->scoreMultiplier = 1;
+	game->numBricks = 0;
+	game->gamePaused = 1; // Make sure the game starts paused
+	game->score = 0; // Set the start score to 0
+	game->gameLost = true; // No game has been started yet
+	game->levelComplete = false;
+	for(n = 0; n < 3; n++)
+	{
+		game->messages[n] = 0;
+	}
+	game->messageTimer = 0;
+
+	// Reset the timing and settings
+	game->gameTick = 0;
+	ResetTimers();
+	game->tickRate = BASETICKRATE;
+	game->tickPhase = 0;
+	game->ballModel = BALLMODEL_LEGACY;
+	game->multiball = false;
+	game->broadPhase = true;
+	ClearEvents();
+	game->gameHooks.sound = NULL; // No hooks until the front end sets them
+	game->gameHooks.levelLoaded = NULL;
+	game->gameHooks.events = NULL;
+
+	SetPoolSizes(MAXBALLS, MAXCOINS, MAXEXPLOSIONS, MAXBULLETS); // Make room for the game objects
+	ClearBricks();
+	LoadLevel(game->level); // Load the starting level
+	ResetExplosions(); // Initiate the explosions
+	ResetBullets(); // Initiate the bullets
+	UseLife(); // Use a life to setup the board elements
+}
+
+void SeedGame(unsigned long long seed) // Start the random streams of the selected game from a seed
+{
+	int n; // Counter
+
+	game->seed = seed;
+	for(n = 0; n < NUM_RANDOMSTREAMS; n++)
+	{
+		SeedRandomStream(game->randoms[n], seed, n); // The same seed, but a different sequence for each stream
+	}
+}
+
+int GameRandom(int stream, int range) // Returns a random number in 0 to range-1 from one of the selected game's random streams
+{
+	return RandomBelow(game->randoms[stream], range);
+}
+
+void SetPoolSizes(int maxBalls, int maxCoins, int maxExplosions, int maxBullets) // Set how many of each game object there is room for
+{
+	// Any objects in play are removed, so a new game should be started after
+	game->balls.Resize(maxBalls);
+	game->coins.Resize(maxCoins);
+	game->explosions.Resize(maxExplosions);
+	game->bullets.Resize(maxBullets);
+}
+
+void StepGame(GameState &state, const TickInput &input) // Run one game update on the given game, leaving the game selected before selected
+{
+	GameSelection select(state); // Selected for the game update only
+
+	StepGame(input);
+}
+
+void StepGame(const TickInput &input) // Run one game update with the given input
+{
+	assert(game != NULL); // SetupGame or SelectGame has to pick the game on this thread first
+
+	SaveLastPositions(); // Remember where everything was so it can be drawn between updates
+
+	// Apply the player's input for this update
+	SetPaddleDirection(input.paddleDirection);
+	if(input.fire) // If the fire button was pressed since the last update...
+	{
+		ReleaseOrFire(); // Release the stuck balls or fire the lasers
+	}
+
+	// Wear off the powerups, messages, no rebound times and explosions due this update
+	AdvanceTimers();
+
+	// Move the paddle one frame if it is currently moving
+	if(GetPaddleDirection())
+	{
+		MovePaddlePosition();
+	}
+
+	MoveBalls(); // Move the balls one frame
+	if(!game->levelComplete) // Once the level is complete nothing else moves in the old level
+	{
+		DropCoins(); // Move the Coins one frame
+		MoveBullets(); // Move the bullets one frame
+	}
+
+	if(game->levelComplete) // If the last brick was knocked out...
+	{
+		PostEvent(EVENT_LEVELCLEARED, 0, 0, 0, game->level);
+		ChangeLevel(1); // Go to the next level
+	}
+	DispatchGameEvents(); // Now everything has moved, add up the score and play the sounds
+
+	game->tickPhase = (game->tickPhase + 1) % TickScale(); // Move on to the next part of the 20 a second update
+}
+
+void SaveLastPositions() // Remember where everything is before a game update moves it
+{
+	int n; // Counter
+
+	game->lastPaddlePos = game->paddlePos;
+	for(n = 0; n < game->balls.Count(); n++)
+	{
+		game->balls[n].lastX = game->balls[n].x;
+		game->balls[n].lastY = game->balls[n].y;
+	}
+	for(n = 0; n < game->coins.Count(); n++)
+	{
+		game->coins[n].lastX = game->coins[n].x;
+		game->coins[n].lastY = game->coins[n].y;
+	}
+	for(n = 0; n < game->bullets.Count(); n++)
+	{
+		game->bullets[n].lastX = game->bullets[n].x;
+		game->bullets[n].lastY = game->bullets[n].y;
+	}
+}
+
+void ChecksumAdd(unsigned int &sum, unsigned int value) // Add a value to a checksum (FNV-1a, a byte at a time)
+{
+	int n; // Counter
+
+	for(n = 0; n < 4; n++)
+	{
+		sum = (sum ^ (value & 255)) * 16777619u;
+		value >>= 8;
+	}
+}
+
+unsigned int GameChecksum() // Returns a hash of everything in the selected game that changes how it plays out
+{
+	// Timers are hashed as the time they have left, so two copies of a game started at different ticks hash the same
+	// Where things were drawn from, the messages and the cosmetic random stream are left out
+	unsigned int sum = 2166136261u; // The checksum so far
+	int n; // Counter
+
+	ChecksumAdd(sum, game->paddleSize);
+	ChecksumAdd(sum, game->paddlePos);
+	ChecksumAdd(sum, game->paddleSpeed);
+	ChecksumAdd(sum, game->paddleDirection);
+	for(n = 0; n < game->balls.Count(); n++)
+	{
+		const Ball &ball = game->balls[n];
+		ChecksumAdd(sum, ball.size);
+		ChecksumAdd(sum, ball.x);
+		ChecksumAdd(sum, ball.y);
+		ChecksumAdd(sum, ball.speedX);
+		ChecksumAdd(sum, ball.speedY);
+		ChecksumAdd(sum, ball.subX);
+		ChecksumAdd(sum, ball.subY);
+		ChecksumAdd(sum, ball.stuck);
+		ChecksumAdd(sum, TimeLeft(ball.fire));
+		ChecksumAdd(sum, TimeLeft(ball.explosive));
+		ChecksumAdd(sum, TimeLeft(ball.noRebound));
+		ChecksumAdd(sum, ball.bricks);
+		ChecksumAdd(sum, ball.greyBricks);
+	}
+	for(n = 0; n < game->coins.Count(); n++)
+	{
+		ChecksumAdd(sum, game->coins[n].x);
+		ChecksumAdd(sum, game->coins[n].y);
+		ChecksumAdd(sum, game->coins[n].rotationPos);
+		ChecksumAdd(sum, game->coins[n].powerup);
+	}
+	for(n = 0; n < game->explosions.Count(); n++)
+	{
+		ChecksumAdd(sum, game->explosions[n].x);
+		ChecksumAdd(sum, game->explosions[n].y);
+		ChecksumAdd(sum, TimeLeft(game->explosions[n].size));
+	}
+	for(n = 0; n < game->bullets.Count(); n++)
+	{
+		ChecksumAdd(sum, game->bullets[n].x);
+		ChecksumAdd(sum, game->bullets[n].y);
+		ChecksumAdd(sum, game->bullets[n].pierce);
+	}
+	for(n = 0; n < BGAMEHEIGHT; n++) // The bricks left, a row at a time
+	{
+		ChecksumAdd(sum, (unsigned int)game->brickGrid.rows[n]);
+		ChecksumAdd(sum, (unsigned int)(game->brickGrid.rows[n] >> 32));
+	}
+	ChecksumAdd(sum, TimeLeft(game->magnetic));
+	ChecksumAdd(sum, TimeLeft(game->laser));
+	ChecksumAdd(sum, game->laserPierce);
+	ChecksumAdd(sum, game->livesRemaining);
+	ChecksumAdd(sum, game->level);
+	ChecksumAdd(sum, game->scoreMultiplier);
+	ChecksumAdd(sum, game->numBricks);
+	ChecksumAdd(sum, game->score);
+	ChecksumAdd(sum, game->gameLost);
+	ChecksumAdd(sum, game->tickRate);
+	ChecksumAdd(sum, game->tickPhase);
+	ChecksumAdd(sum, game->ballModel);
+	for(n = 0; n < NUM_RANDOMSTREAMS; n++)
+	{
+		if(n != RANDOM_COSMETIC)
+		{
+			ChecksumAdd(sum, (unsigned int)game->randoms[n].state);
+			ChecksumAdd(sum, (unsigned int)(game->randoms[n].state >> 32));
+		}
+	}
+	return sum;
+}
+
+bool SetTickRate(int rate) // Change the number of game updates a second
+{
+	int oldScale = TickScale(); // Updates per 20 a second update before the change
+
+	if(rate < BASETICKRATE || rate > MAXTICKRATE || rate % BASETICKRATE) // Only whole multiples of 20 a second are allowed
+	{
+		return false;
+	}
+
+	game->tickRate = rate;
+	game->tickPhase = 0; // Start the next update at the beginning of a 20 a second update
+	RescaleTimers(oldScale, TickScale()); // Keep the running timers lasting the same time
+	return true;
+}
+
+int GetTickRate() // Returns the number of game updates a second
+{
+	return game->tickRate;
+}
+
+int TickScale() // Number of game updates in the time of one 20 a second update
+{
+	return game->tickRate / BASETICKRATE;
+}
+
+int ScaleTicks(int ticks) // Converts a count of 20 a second frames into game updates at the current rate
+{
+	return ticks * TickScale();
+}
+
+int TickShare(int amount) // The part of a 20 a second update's movement that is made in this game update
+{
+	// Spread the amount evenly over the updates, so together they add up to exactly the amount
+	return amount*(game->tickPhase + 1)/TickScale() - amount*game->tickPhase/TickScale();
+}
+
+int RescaleTimer(int ticks, int oldScale, int newScale) // Converts a running timer from one tick scale to another
+{
+	if(ticks <= 0) // Stopped and inactive timers stay as they are
+	{
+		return ticks;
+	}
+	ticks = ticks * newScale / oldScale;
+	return ticks > 0 ? ticks : 1; // A running timer keeps running
+}
+
+void RescaleTimers(int oldScale, int newScale) // Converts all the running timers from one tick scale to another
+{
+	int n; // Counter
+
+	if(oldScale == newScale)
+	{
+		return;
+	}
+
+	game->magnetic = RescaleDue(TIMER_MAGNETIC, NOTIMEROWNER, game->magnetic, oldScale, newScale);
+	game->laser = RescaleDue(TIMER_LASER, NOTIMEROWNER, game->laser, oldScale, newScale);
+	game->messageTimer = RescaleDue(TIMER_MESSAGE, NOTIMEROWNER, game->messageTimer, oldScale, newScale);
+	for(n = 0; n < game->balls.Count(); n++)
+	{
+		game->balls[n].fire = RescaleDue(TIMER_FIRE, game->balls.Handle(n), game->balls[n].fire, oldScale, newScale);
+		game->balls[n].explosive = RescaleDue(TIMER_EXPLOSIVE, game->balls.Handle(n), game->balls[n].explosive, oldScale, newScale);
+		game->balls[n].noRebound = RescaleDue(TIMER_NOREBOUND, game->balls.Handle(n), game->balls[n].noRebound, oldScale, newScale);
+	}
+	for(n = 0; n < game->explosions.Count(); n++)
+	{
+		game->explosions[n].size = RescaleDue(TIMER_EXPLOSION, game->explosions.Handle(n), game->explosions[n].size, oldScale, newScale);
+	}
+	for(n = 0; n < game->coins.Count(); n++)
+	{
+		game->coins[n].rotationPos = game->coins[n].rotationPos * newScale / oldScale; // Keep the same rotation
+	}
+}
+
+int RescaleDue(int kind, PoolHandle owner, int due, int oldScale, int newScale) // Returns the tick a running effect wears off on in the new tick scale, and schedules it
+{
+	if(due <= 0) // Effects that aren't running stay as they are
+	{
+		return due;
+	}
+	return StartTimer(kind, owner, RescaleTimer(TimeLeft(due), oldScale, newScale)); // The old event finds the tick changed and is ignored
+}
+
+void TimerExpired(const TimerEvent &event) // A timed effect has worn off, called by the timer wheel
+{
+	int n; // The ball or explosion the effect belongs to
+
+	// An effect that was extended, rescaled or reset since the event was scheduled no longer wears off on the event's tick,
+	// and one belonging to a ball or explosion that has gone can't be found, either way there is nothing to do
+	switch(event.kind)
+	{
+	case TIMER_MAGNETIC:
+		if(game->magnetic == event.due)
+		{
+			game->magnetic = 0;
+		}
+		return;
+	case TIMER_LASER:
+		if(game->laser == event.due)
+		{
+			game->laser = 0;
+			game->laserPierce = 0; // Piercing shots wear off with the lasers
+		}
+		return;
+	case TIMER_MESSAGE:
+		if(game->messageTimer == event.due)
+		{
+			game->messageTimer = 0;
+			RemoveMessage(); // Move on to the next message
+		}
+		return;
+	case TIMER_FIRE:
+		n = game->balls.Find(event.owner);
+		if(n != -1 && game->balls[n].fire == event.due)
+		{
+			game->balls[n].fire = 0;
+		}
+		return;
+	case TIMER_EXPLOSIVE:
+		n = game->balls.Find(event.owner);
+		if(n != -1 && game->balls[n].explosive == event.due)
+		{
+			game->balls[n].explosive = 0;
+		}
+		return;
+	case TIMER_NOREBOUND:
+		n = game->balls.Find(event.owner);
+		if(n != -1 && game->balls[n].noRebound == event.due)
+		{
+			game->balls[n].noRebound = 0;
+		}
+		return;
+	case TIMER_EXPLOSION:
+		n = game->explosions.Find(event.owner);
+		if(n != -1 && game->explosions[n].size == event.due)
+		{
+			RemoveExplosion(n); // The last explosion takes its place
+		}
+		return;
+	}
+}
+
+void ReleaseOrFire() // Release any stuck balls, or fire the lasers if none are stuck
+{
+	int n; // Counter
+	bool noneStuck = true; // No stuck balls found so far
+
+	// Release any balls stuck to the paddle
+	n = 0;
+	while(n < game->balls.Count())
+	{
+		if(game->balls[n].stuck) // If ball n is stuck...
+		{
+			ReleaseBall(n); // Release it
+			noneStuck = false; // Found a stuck ball
+		}
+		n++;
+	}
+
+	if(noneStuck) // If no stuck balls were found...
+	{
+		if(game->laser > 0) // If lasers are active...
+		{
+			AddBullets(); // Fire the bullets
+		}
+	}
+}
+
+void AddSound(const std::string &sound) // Pass a sound on to the sound hook, if there is one
+{
+	if(game->gameHooks.sound) // If the front end wants sounds...
+	{
+		game->gameHooks.sound(sound); // Let it play the sound
+	}
+}
+
+void DispatchGameEvents() // Add up the score, play the sounds and pass on the events of the game update
+{
+	size_t n; // Counter
+	const std::string *sound; // The sound of an event
+
+	for(n = 0; n < game->gameEvents.size(); n++)
+	{
+		if(game->gameEvents[n].type == EVENT_BRICKDESTROYED) // If a brick was knocked out...
+		{
+			game->score += game->gameEvents[n].value; // Add on its points
+		}
+		sound = EventSound(game->gameEvents[n]);
+		if(sound) // If the event makes a sound...
+		{
+			AddSound(*sound); // Play it
+		}
+	}
+
+	if(game->gameHooks.events && !game->gameEvents.empty()) // If the front end wants the events...
+	{
+		game->gameHooks.events(&game->gameEvents[0], (int)game->gameEvents.size()); // Let it have them all at once
+	}
+	ClearEvents(); // Ready for the next game update
+}
+
+const std::string *EventSound(const GameEvent &event) // Returns the sound an event makes
+{
+	switch(event.type)
+	{
+	case EVENT_BRICKDESTROYED:
+		return event.detail == CAUSE_EXPLOSION ? NULL : &SOUND_BRICKKO; // Bricks caught in an explosion go quietly
+	case EVENT_REBOUND:
+		if(event.detail == REBOUND_PADDLE)
+		{
+			return &SOUND_PADDLEREBOUND;
+		}
+		return event.detail == REBOUND_BRICK ? &SOUND_BRICKREBOUND : &SOUND_BORDERREBOUND;
+	case EVENT_COINCOLLECTED:
+		return &SOUND_COIN;
+	case EVENT_POWERUPGAINED:
+		return PowerupSound(event.value);
+	case EVENT_LIFELOST:
+		return &SOUND_LOSELIFE;
+	case EVENT_GAMELOST:
+		return &SOUND_GAMEOVER;
+	case EVENT_LASERFIRED:
+		return &SOUND_LASERFIRE;
+	case EVENT_CHAINREACTION:
+		return &SOUND_EXPLOSIVE;
+	case EVENT_LEVELSTARTED:
+		return event.detail ? &SOUND_LOSELIFE : NULL; // Resetting the ball during play has always used the lose life sound
+	}
+	return NULL;
+}
+
+const std::string *PowerupSound(int powerup) // Returns the sound a powerup makes when gained
+{
+	switch(powerup)
+	{
+	case INCPADDLESIZE:
+		return &SOUND_PADDLESIZEINC;
+	case DECPADDLESIZE:
+		return &SOUND_PADDLESIZEDEC;
+	case INCPADDLESPEED:
+		return &SOUND_PADDLESPEEDINC;
+	case DECPADDLESPEED:
+		return &SOUND_PADDLESPEEDDEC;
+	case INCBALLSIZE:
+		return &SOUND_BALLSIZEINC;
+	case DECBALLSIZE:
+		return &SOUND_BALLSIZEDEC;
+	case EXTRABALL:
+		return &SOUND_EXTRABALL;
+	case EXTRALIFE:
+		return &SOUND_EXTRALIFE;
+	case MAGNETIC:
+		return &SOUND_MAGNETISM;
+	case FIREBALL:
+		return &SOUND_FIREBALL;
+	case GUNS:
+		return &SOUND_GUNS;
+	case EXPLOSIVE:
+		return &SOUND_EXPLOSIVE;
+	}
+	return NULL; // The ball speed powerups aren't used anymore and have no sound
+}
+
+void UseLife() // Lose a life and reset the necessary elements
+{
+	int n; // The starting ball
+
+	// Start by removing all the balls
+	game->balls.Clear();
+
+	// If there are lives left then set up the initial ball
+	if(game->livesRemaining > 0)
+	{
+		// Set the starting ball to the middle of the paddle
+		n = game->balls.Add(); // There is always room as the pool was just emptied
+		game->balls[n].size = 4;
+		game->balls[n].x = GetPaddlePosition() + (GetPaddleSize()+2)*4 - TILESIZE;
+		game->balls[n].y = 479 - 14 - (9+(game->balls[n].size));
+		game->balls[n].speedX = 0;
+		game->balls[n].speedY = 0;
+		game->balls[n].subX = SUBPIXELS/2; // Start in the middle of the pixel
+		game->balls[n].subY = SUBPIXELS/2;
+		game->balls[n].speedMod = 0;
+		game->balls[n].stuck = true;
+		game->balls[n].fire = 0;
+		game->balls[n].explosive = 0;
+		game->balls[n].noRebound = 0;
+		game->balls[n].bricks = 1;
+		game->balls[n].greyBricks = 0;
+		game->balls[n].lastX = game->balls[n].x; // Don't draw the ball sliding in from where it was lost
+		game->balls[n].lastY = game->balls[n].y;
+
+		// Reset powerups
+		game->paddleSize = INITPADDLESIZE;
+		game->paddleSpeed = INITPADDLESPEED;
+		game->magnetic = 0;
+		game->laser = 0;
+		game->laserPierce = 0;
+
+		// Remove a life
+		game->livesRemaining--;
+	} else { // If there were no lives left
+		GameOver(); // Game is lost
+	}
+}
+
+void GameOver() // Game is over
+{
+	PostEvent(EVENT_GAMELOST, 0, 0, 0, game->level); // Play the lose game sound
+	game->gameLost = true;
+	game->gamePaused = 1;	// Pause the game
+}
+
+void StartGame() // Start a new game
+{
+	// Reset the paddle
+	game->paddleSize = 8;
+	game->paddlePos = 279;
+	game->lastPaddlePos = game->paddlePos;
+	game->paddleSpeed = 4;
+	game->paddleDirection = 0;
+	
+	game->livesRemaining = 4; // Reset the lives to 4 (one will be used)
+	game->level = 1; // Reset the level to 1
+	game->scoreMultiplier = 1; // Reset the score multiplier to 1
+	game->score = 0; // Reset the score to 0
+	game->levelComplete = false;
+	ClearEvents(); // Anything left over from the last game doesn't count
+
+	// Clear what was left moving when the last game ended and restart the clock,
+	//   so every game starts the same way and a replay of it plays out the same
+	ClearCoins();
+	ResetExplosions();
+	ResetBullets();
+	ClearMessages();
+	ResetTimers();
+	game->gameTick = 0;
+	game->tickPhase = 0;
+
+	LoadLevel(game->level); // Load the starting level
+	PostEvent(EVENT_LEVELSTARTED, !game->gamePaused, 0, 0, game->level);
+	UseLife(); // Use a life
+	if(game->gameHooks.levelLoaded) // If the front end wants to know about new levels...
+	{
+		game->gameHooks.levelLoaded(game->level); // Let it load the level background
+	}
+	
+	game->gameLost = false; // New game isn't lost
+	UnpauseGame(); // Unpause the game
+}
+
+void AdjustPaddleSize(int size) // Change the paddle size
+{
+	if(size > 0) // If the size change is positive...
+	{
+		game->paddleSize++; // Increase the paddle size by one
+	}
+	if(size < 0) // If the size change is negative...
+	{
+		game->paddleSize--; // Decrease the paddle size by one
+	}
+	if(game->paddleSize < 2) // Paddle size can not go below two
+	{
+		game->paddleSize = 2;
+	}
+	if(game->paddleSize > 14) // Paddle size can not go above fourteen
+	{
+		game->paddleSize = 14;
+	}
+	// Make sure the paddle doesn't go beyond the borders
+	if(GetPaddlePosition() + 8*(GetPaddleSize()+2) >= GAMEWIDTH*TILESIZE - 9)
+	{
+		game->paddlePos = GAMEWIDTH*TILESIZE - 9 - 8*(GetPaddleSize()+2); // Move the paddle if necessary
+	}
+	return;
+}
+
+int GetPaddleSize() // Gives the size of the paddle
+{
+	return game->paddleSize;
+}
+
+void MovePaddlePosition() // Move the paddle
+{ 
+	int n; // Counter
+	int m; // Pixels moved so far
+	int steps; // Number of pixels the paddle moves this game update
+	int clear; // Number of pixels the paddle can move before it touches a border or a ball
+	const PaddleProfile &push = GetPaddleProfile(PADDLEPROFILE_PUSH, GetPaddleSize()); // The paddle as seen when it moves into a ball
+
+	// Sweep the paddle over the pixels it moves this game update
+	steps = TickShare(GetPaddleSpeed()); // At faster update rates the speed is spread over several updates
+	m = 0;
+	while(m < steps)
+	{
+		// Jump straight over the pixels where nothing happens, carrying any stuck balls along
+		clear = PaddleClearSteps(push, steps - m);
+		if(clear > 0)
+		{
+			game->paddlePos += GetPaddleDirection() * clear;
+			n = 0;
+			while(n < game->balls.Count())
+			{
+				if(game->balls[n].stuck)
+				{
+					game->balls[n].x += GetPaddleDirection() * clear;
+				}
+				n++;
+			}
+			m += clear;
+		}
+
+		// Then make the pixel step where the paddle meets something one pixel at a time
+		if(m < steps)
+		{
+			if(!PaddleStep(push)) // If the paddle stopped...
+			{
+				return;
+			}
+			m++;
+		}
+	}
+}
+
+int StepsToReach(int pos, int dir, int low, int high) // Number of pixel steps from pos before a step lands in low to high (-1 = never)
+{
+	int k; // Steps before the first step that lands in the range
+
+	if(dir > 0)
+	{
+		k = low - pos - 1;
+		k = k > 0 ? k : 0;
+		return pos + k + 1 <= high ? k : -1;
+	}
+	k = pos - 1 - high;
+	k = k > 0 ? k : 0;
+	return pos - k - 1 >= low ? k : -1;
+}
+
+int PaddleClearSteps(const PaddleProfile &push, int maxSteps) // Number of pixels the paddle can move before it touches a border or a ball
+{
+	const int FAR = 1 << 30; // Further than anything on the board
+	int dir = GetPaddleDirection(); // Which way the paddle moves
+	int clear = maxSteps; // Pixels clear so far
+	int n, y; // Counters
+	int x; // Edge pixel of a ball row
+	int row; // Row of the paddle profile a ball row is on
+	int first, last; // Rows of the ball in line with the paddle
+	int k; // Steps before something is touched
+
+	// The board borders, both are checked as a paddle that grew next to a border can already be past it
+	k = StepsToReach(game->paddlePos, dir, -FAR, TILESIZE - 1);
+	if(k != -1 && k < clear)
+	{
+		clear = k;
+	}
+	k = StepsToReach(game->paddlePos, dir, TILESIZE*GAMEWIDTH - TILESIZE - TILESIZE*(GetPaddleSize()+2) + 1, FAR);
+	if(k != -1 && k < clear)
+	{
+		clear = k;
+	}
+
+	n = 0;
+	while(n < game->balls.Count())
+	{
+		if(game->balls[n].stuck) // Stuck balls stop the paddle when they are pushed into a border
+		{
+			if(dir > 0)
+			{
+				k = StepsToReach(game->balls[n].x, dir, (GAMEWIDTH*TILESIZE) - TILESIZE - (TILESIZE*2 - (7 - game->balls[n].size)) + 1, FAR);
+			}
+			else
+			{
+				k = StepsToReach(game->balls[n].x, dir, -FAR, TILESIZE - (7 - game->balls[n].size) - 1);
+			}
+			if(k != -1 && k < clear)
+			{
+				clear = k;
+			}
+		}
+		else if(game->balls[n].noRebound <= 0) // Other balls stop it when it hits them
+		{
+			// Only the rows of the ball in line with the paddle can be hit
+			first = push.top - game->balls[n].y;
+			first = first > 0 ? first : 0;
+			last = push.top + push.rows - 1 - game->balls[n].y;
+			last = last < 15 ? last : 15;
+			for(y = first; y <= last; y++)
+			{
+				x = GetBallShape(game->balls[n].size).right[y];
+				if(x > 0) // If a ball pixel exists in that row...
+				{
+					// The paddle positions where the pixel or its mirror opposite lie on the paddle
+					row = game->balls[n].y + y - push.top;
+					k = StepsToReach(game->paddlePos, dir, game->balls[n].x + x - push.last[row], game->balls[n].x + x - push.first[row]);
+					if(k != -1 && k < clear)
+					{
+						clear = k;
+					}
+					k = StepsToReach(game->paddlePos, dir, game->balls[n].x + (15-x) - push.last[row], game->balls[n].x + (15-x) - push.first[row]);
+					if(k != -1 && k < clear)
+					{
+						clear = k;
+					}
+				}
+			}
+		}
+		n++;
+	}
+
+	return clear;
+}
+
+bool PaddleStep(const PaddleProfile &push) // Move the paddle one pixel and deal with anything it touches, returns false if it has to stop
+{
+	int n; // Counter
+	int x, y; // More counters
+	int tempPos; // Temporary paddle position for collision calculations
+	int ballAdj; // Number of pixels to move all remaining stuck balls
+	bool stop = false; // Set when the paddle can't move any further this game update
+
+	bool ballBounced; // Used when checking if the paddle hit a ball
+	bool paddleOverlap; // Used when checking if the paddle overlaps the ball when pushed against a border
+	// bool coinCollected; // Used when checking if the paddle hit a powerup coin
+
+	if( (GetPaddlePosition() + GetPaddleDirection()) < TILESIZE)
+	{  // If the paddle hits the left border...
+		SetPaddleDirection(0); // Stop the paddle form moving
+		return false;
+	}
+	if (GetPaddlePosition() + GetPaddleDirection() + (TILESIZE*2 + GetPaddleSize()*TILESIZE) >= (TILESIZE*GAMEWIDTH-TILESIZE+1))
+	{ // If the paddle hits the right border...
+		SetPaddleDirection(0); // Stop the paddle form moving
+		return false;
+	}
+
+	tempPos = game->paddlePos + GetPaddleDirection(); // Calculate whe the paddle is moving to
+
+	// Move all balls that are stuck and check the rest for collisions
+	n = 0;
+	while(n < game->balls.Count())
+	{
+		ballBounced = false; // Ball not hit
+
+		if(!game->balls[n].stuck) // Check for collision with balls that aren't stuck to it
+		{
+			// Check each pixel row of the ball
+			for(y = 0; y < 16; y++)
+			{
+				// Find the right most pixel of the ball in each row
+				x = GetBallShape(game->balls[n].size).right[y];
+				if(x > 0) // If a ball pixel exists in that row...
+				{
+					// Then check that pixel and it's mirror opposite against each its corresponding row on the paddle
+					if(OnPaddle(push, tempPos, game->balls[n].x + x, game->balls[n].y + y) ||
+						OnPaddle(push, tempPos, game->balls[n].x + (15-x), game->balls[n].y + y))
+					{
+						ballBounced = true; // Paddle hit the ball
+					}
+				}
+			}
+		}
+
+		if(ballBounced) // If the paddle hit the ball...
+		{
+			if(game->balls[n].noRebound <= 0) // If the ball is allowed to rebound off the paddle...
+			{
+				PostEvent(EVENT_REBOUND, REBOUND_PADDLE, game->balls[n].x, game->balls[n].y, 0); // Play the ball hitting the paddle sound
+				if(game->magnetic) // If the magnetic ability is on...
+				{
+					game->balls[n].stuck = true; // The ball becomes stuck to the paddle
+					game->balls[n].speedX = 0;
+					game->balls[n].speedY = 0;
+				}
+				else // If the paddle is not magnetic...
+				{
+					ReleaseBall(n); // Then the ball bounces off in a direction depending on where it hit
+				}
+				stop = true; // Stop moving the paddle when it hits a ball
+			}
+		}
+
+		ballAdj = 0; // Currently there is no extra ball adjustment
+
+		if(game->balls[n].stuck) // Move stuck and newly stuck balls
+		{
+			game->balls[n].x += GetPaddleDirection(); // Move the stuck ball as well
+			game->balls[n].x += ballAdj; // Move the ball any extra adjuments created by previous stuck balls
+			
+			if(GetPaddleDirection() > 0) // If the paddle moved right...
+			{
+				if( game->balls[n].x > (GAMEWIDTH*TILESIZE) - TILESIZE - (TILESIZE*2 - (7 - game->balls[n].size)) )
+				// If the ball moves past the border...
+				{
+					paddleOverlap = false; // Paddle doesn't overlap the ball yet
+
+					// Move the ball back into the game
+					game->balls[n].x = (GAMEWIDTH*TILESIZE) - TILESIZE - (TILESIZE*2 - (7 - game->balls[n].size));
+
+					if( game->balls[n].y > (GAMEHEIGHT*TILESIZE) - (2*TILESIZE-2) - (2*TILESIZE - (7 - game->balls[n].size)) )
+					// If the ball isn't sitting on top of the paddle...
+					{
+						// Move the ball up one pixel on the paddle
+						game->balls[n].y--;
+					}
+					
+					// Check each pixel row of the ball
+					for(y = 0; y < 16; y++)
+					{
+						// Find the left most pixel of the ball in each row
+						x = GetBallShape(game->balls[n].size).left[y];
+						if(x != -1) // If a ball pixel exists in that row...
+						{
+							// Then check that pixel against each its corresponding row on the paddle
+							if(OnPaddle(push, tempPos, game->balls[n].x + x, game->balls[n].y + y))
+							{
+								paddleOverlap = true; // Paddle overlaps the ball
+							}
+						}
+					}
+
+					if(paddleOverlap) // If the paddle overlaps the ball...
+					{
+						game->paddlePos--; // Move the paddle left one
+						ballAdj--; // All other stuck balls move left one too
+					}
+					
+					stop = true; // Stop moving the paddle when the ball is pushed against the border
+				}
+			}
+			else // If the paddle moved left...
+			{							
+				if( game->balls[n].x < TILESIZE - (7 - game->balls[n].size) )
+				// If the ball moves past the border...
+				{
+					paddleOverlap = false; // Paddle doesn't overlap the ball yet
+
+					// Move the ball back into the game
+					game->balls[n].x = TILESIZE - (7 - game->balls[n].size);
+
+					if( game->balls[n].y > (GAMEHEIGHT*TILESIZE) - (2*TILESIZE-2) - (2*TILESIZE - (7 - game->balls[n].size)) )
+					// If the ball isn't sitting on top of the paddle...
+					{
+						// Move the ball up one pixel on the paddle
+						game->balls[n].y--;
+					}
+					
+					// Check each pixel row of the ball
+					for(y = 0; y < 16; y++)
+					{
+						// Find the right most pixel of the ball in each row
+						x = GetBallShape(game->balls[n].size).right[y];
+						if(x != -1) // If a ball pixel exists in that row...
+						{
+							// Then check that pixel against each its corresponding row on the paddle
+							if(OnPaddle(push, tempPos, game->balls[n].x + x, game->balls[n].y + y))
+							{
+								paddleOverlap = true; // Paddle overlaps the ball
+							}
+						}
+					}
+
+					if(paddleOverlap) // If the paddle overlaps the ball...
+					{
+						game->paddlePos++; // Move the paddle right one
+						ballAdj++; // All other stuck balls move right one too
+					}
+					
+					stop = true; // Stop moving the paddle when the ball is pushed against the border
+				}
+			}
+		}
+
+		n++;
+	}
+	
+	/*
+	n = 0;
+	while(n < 20)
+	{
+		if(!coins[n].rotationPos) // Stop when no more coins exist
+		{
+			break;
+		}
+		
+		coinCollected = false; // Coin not hit
+
+		// Check for collision with a coin			
+		for(y = 0; y < 16; y++) // Check each pixel row of the coin
+		{
+			// Find the right most pixel of the coin in each row
+			x = 16;
+			while(x > 0)
+			{
+				if(coinMap[coins[n].rotationPos/COINSPEED][x][y])
+				{
+					break;
+				}
+				x--;
+			}
+			if(x) // If a coin pixel exists in that row...
+			{
+				// Then check that pixel and it's mirror opposite against each its corresponding row on the paddle
+				if(coins[n].y + y >= (GAMEHEIGHT*TILESIZE-1) - (TILESIZE*2-2) &&
+					coins[n].y + y < GAMEHEIGHT*TILESIZE-2)
+				{
+					if(coins[n].y + y >= (GAMEHEIGHT*TILESIZE-1) - (TILESIZE*2-2) +1 &&
+						coins[n].y + y < GAMEHEIGHT*TILESIZE-3)
+					{
+						if(coins[n].y + y >= (GAMEHEIGHT*TILESIZE-1) - (TILESIZE*2-2) +2 &&
+							coins[n].y + y < GAMEHEIGHT*TILESIZE-4)
+						{
+							if(coins[n].x + x >= tempPos && coins[n].x + x < tempPos + 8*(GetPaddleSize()+2) ||
+								coins[n].x + (15-x) >= tempPos && coins[n].x + (15-x) < tempPos + 8*(GetPaddleSize()+2) )
+							{
+								coinCollected = true; // Paddle hit the coin
+							}
+						}
+						if(coins[n].x + x >= tempPos + 1 && coins[n].x + x < tempPos + 8*(GetPaddleSize()+2) - 1 ||
+							coins[n].x + (15-x) >= tempPos + 1 && coins[n].x + (15-x) < tempPos + 8*(GetPaddleSize()+2) - 1)
+						{
+							coinCollected = true; // Paddle hit the coin
+						}
+					}
+					if(coins[n].x + x >= tempPos + 3 && coins[n].x + x < tempPos + 8*(GetPaddleSize()+2) - 3 ||
+						coins[n].x + (15-x) >= tempPos + 3 && coins[n].x + (15-x) < tempPos + 8*(GetPaddleSize()+2) - 3)
+					{
+						coinCollected = true; // Paddle hit the coin
+					}
+				}
+			}
+		}
+
+		if(coinCollected) // If the paddle hit the coin...
+		{
+			AddSound(SOUND_COIN); // Play the coin collection sound
+			GainPowerup(coins[n].powerup); // Gain the coin's powerup
+			LoseCoin(n); // Remove the coin from the game
+		}
+
+		n++;
+	}
+	*/
+
+	game->paddlePos += GetPaddleDirection(); // Move the paddle
+
+	return !stop;
+}
+
+int GetPaddlePosition() // Gives the x position of the left side of the paddle
+{
+	return game->paddlePos;
+}
+
+void AdjustPaddleSpeed(int speedChange) // Change the speed with which the paddle moves
+{
+	if(speedChange > 0) // If the speed change is positive...
+	{
+		game->paddleSpeed++; // Increase the speed by one
+	}
+	if(speedChange < 0) // If the speed change is negative...
+	{
+		game->paddleSpeed--; // Decrease the speed by one
+	}
+	if(game->paddleSpeed < 2) // The speed can not be less than two
+	{
+		game->paddleSpeed = 2;
+	}
+	if(game->paddleSpeed > 10) // The speed can not be greater than ten
+	{
+		game->paddleSpeed = 10;
+	}
+}
+
+int GetPaddleSpeed() // Gives the paddle's speed
+{
+	return game->paddleSpeed;
+}
+
+void ReleaseBall(int num) // Releases the ball from the paddle in a direction depending on its placement on the paddle
+{
+	int ballPadPos; // Position where the ball touchs the paddle
+	int padPixels; // Number of pixels in the paddle
+
+	game->balls[num].stuck = false; // Ball is no longer stuck
+	game->balls[num].noRebound = StartTimer(TIMER_NOREBOUND, game->balls.Handle(num), ScaleTicks(NOREBOUNDTIME)); // Ball can not be hit again for 4 frames
+	game->balls[num].greyBricks = 0; // Reset the grey brick count
+
+	//Ball Position + TILESIZE to refer to the centre of the ball - Paddle Position
+	ballPadPos = game->balls[num].x + TILESIZE - GetPaddlePosition();
+
+	// (Paddle size + 2) * TILESIZE
+	padPixels = (GetPaddleSize() + 2) * TILESIZE; // 48, 56, 64, 72, 80, 88, 96, 104, 112
+	
+	// How the direction of release should be broken up over the pixels of the paddle depending on paddle size
+	// 0-5, 6-11, 12-17, 18-23, 24-29, 30-35, 36-41, 42-47
+	// 0-6, 7-13, 14-20, 21-27, 28-34, 35-41, 42-48, 49-55
+	// 0-7, 8-15, 16-23, 24-31, 32-39, 40-47, 48-55, 56-63	
+	// 0-8, 9-17, 18-26, 27-35, 36-44, 45-53, 54-62, 63-71
+	// 0-9, 10-19, 20-29, 30-39, 40-49, 50-59, 60-69, 70-79
+	// 0-10, 11-21, 22-32, 33-43, 44-54, 55-65, 66-76, 77-87
+	// 0-11, 12-23, 24-35, 36-47, 48-59, 60-71, 72-83, 84-95
+	// 0-12, 13-25, 26-38, 39-51, 52-64, 65-77, 78-90, 91-103
+	// 0-13, 14-27, 28-41, 42-55, 56-69, 70-83, 84-97, 98-111
+
+	if(game->ballModel == BALLMODEL_SMOOTH) // If the ball can go in any direction...
+	{
+		// Keep the contact point on the paddle
+		if(ballPadPos < 0)
+		{
+			ballPadPos = 0;
+		}
+		if(ballPadPos > padPixels)
+		{
+			ballPadPos = padPixels;
+		}
+
+		// Send it off at an angle set by how far from the middle of the paddle it hit, keeping the same speed
+		game->balls[num].speedX = SMOOTHBALLSPEED * SMOOTHMAXANGLE * (2*ballPadPos - padPixels) / (16*padPixels);
+		if(abs(game->balls[num].speedX) < SMOOTHBALLSPEED * SMOOTHMINANGLE / 16) // Like the original, never send the ball straight up
+		{
+			game->balls[num].speedX = SMOOTHBALLSPEED * SMOOTHMINANGLE / 16 * (2*ballPadPos >= padPixels ? 1 : -1);
+		}
+		game->balls[num].speedY = -IntSqrt((long long)SMOOTHBALLSPEED*SMOOTHBALLSPEED - (long long)game->balls[num].speedX*game->balls[num].speedX);
+		return;
+	}
+
+	game->balls[num].speedX = (ballPadPos/(GetPaddleSize() +2)) - 4; // SpeedX of the ball between -4 and 3
+	if(game->balls[num].speedX >= 0) // SpeedX of the between -4 and 4, excluding 0
+		game->balls[num].speedX++;
+	if(game->balls[num].speedX > 4) // Ensure speedX of the ball isn't greater than 4
+		game->balls[num].speedX = 4;
+	if(game->balls[num].speedX < -4) // Ensure speedX of the ball isn't lower than -4
+		game->balls[num].speedX = -4;
+
+	// Set the Y speed of the ball based on the X speed
+	game->balls[num].speedY = abs(game->balls[num].speedX) - LEGACYBALLSTEPS; // between -1 and -5
+	if(game->balls[num].speedY >= 0) // Ensure there are no speeds above -1
+	{
+		game->balls[num].speedY = -1;
+	}
+
+	// Whole pixels a 20 a second update
+	game->balls[num].speedX *= SUBPIXELS;
+	game->balls[num].speedY *= SUBPIXELS;
+}
+
+void MoveBalls() // Move all the balls currently on the game board
+{
+	int num; // ball number
+	PoolHandle handle; // The ball being moved
+
+	// Move each of the balls
+	num = 0;
+	while(num < game->balls.Count() && !game->levelComplete) // Once the level is complete the balls stop until the next level loads
+	{
+		// Ignore balls that are stuck
+		if(game->balls[num].stuck == false)
+		{
+			handle = game->balls.Handle(num);
+			SweepBall(num); // Move the ball its full speed, stopping at the first thing it hits
+			if(game->balls.Find(handle) != num) // If the ball was lost, another ball has taken its place...
+			{
+				continue; // So move that one next
+			}
+		}
+		num++;
+	}
+}
+
+int FirstCrossing(int sub, int dir) // 1/256ths of a pixel a ball moves in direction dir before its first pixel step
+{
+	// The ball is in pixel x while its fixed point position is from x to just under x+1
+	if(dir > 0)
+	{
+		return SUBPIXELS - sub;
+	}
+	return sub + 1;
+}
+
+int StepsWithin(long long distance, int first) // Number of pixel steps made moving distance 1/256ths of a pixel
+{
+	if(distance < first) // If it doesn't reach the first pixel step...
+	{
+		return 0;
+	}
+	return (int)((distance - first) / SUBPIXELS) + 1;
+}
+
+bool StepXFirst(int countX, int countY, int firstX, int firstY, int distX, int distY) // Does the countX'th horizontal step come before the countY'th vertical step
+{
+	// Each step happens part way through the move, at its distance along the axis over the distance moved on that axis
+	// Comparing these with both sides multiplied up keeps it exact, and a tie goes to the horizontal step
+	return (long long)(firstX + SUBPIXELS*(countX - 1)) * distY <= (long long)(firstY + SUBPIXELS*(countY - 1)) * distX;
+}
+
+void ReflectBall(int num, int normalX, int normalY) // Bounce a ball off a surface facing normalX,normalY
+{
+	// Take away twice the part of the speed going into the surface, which for a surface facing along an axis
+	// or at 45 degrees (normal parts of -1, 0 or 1) comes out in whole numbers
+	int dot = game->balls[num].speedX*normalX + game->balls[num].speedY*normalY; // Speed into the surface, times the normal's length
+	int lengthSquared = normalX*normalX + normalY*normalY; // Normal's length squared
+
+	if(lengthSquared == 0) // A surface has to face somewhere
+	{
+		return;
+	}
+	game->balls[num].speedX -= 2*dot*normalX / lengthSquared;
+	game->balls[num].speedY -= 2*dot*normalY / lengthSquared;
+}
+
+int BallDirection(int num) // The nearest of the nine original directions (-4 to 4) to the way the ball is moving
+{
+	// The original balls split 5 pixels between the axes, so scale the speed to 5 pixels and round the horizontal part
+	int total = abs(game->balls[num].speedX) + abs(game->balls[num].speedY); // Speed along both axes
+	int direction; // Nearest original horizontal speed
+
+	if(total == 0) // If the ball isn't moving...
+	{
+		return 0;
+	}
+	direction = (2*LEGACYBALLSTEPS*abs(game->balls[num].speedX) + total) / (2*total);
+	if(direction > LEGACYBALLSTEPS - 1)
+	{
+		direction = LEGACYBALLSTEPS - 1;
+	}
+	return game->balls[num].speedX < 0 ? -direction : direction;
+}
+
+void SetBallModel(int model) // Change how the balls move and rebound off the paddle
+{
+	if(model < 0 || model >= NUM_BALLMODELS) // If the model doesn't exist...
+	{
+		return;
+	}
+	game->ballModel = model; // Takes effect the next time each ball leaves the paddle
+}
+
+int GetBallModel() // Returns how the balls move and rebound off the paddle
+{
+	return game->ballModel;
+}
+
+void SetMultiball(bool on) // Turn the multiball mode on or off, start a new game after
+{
+	game->multiball = on;
+	SetPoolSizes(game->multiball ? MULTIBALLMAXBALLS : MAXBALLS, MAXCOINS, MAXEXPLOSIONS, game->multiball ? MULTIBALLMAXBULLETS : MAXBULLETS); // Make room for the balls and their bullets
+}
+
+bool GetMultiball() // Is the multiball mode on
+{
+	return game->multiball;
+}
+
+void SetBroadPhase(bool on) // Turn the clear move check before the step by step sweep on or off (for timing it)
+{
+	game->broadPhase = on;
+}
+
+int IntSqrt(long long n) // Returns the whole square root of n
+{
+	long long root = 0; // The root so far
+	long long bit = 1LL << 62; // The next bit of the root squared to try
+
+	if(n <= 0)
+	{
+		return 0;
+	}
+	while(bit > n)
+	{
+		bit >>= 2;
+	}
+	// Work the root out one bit at a time, so it's the same on every machine
+	while(bit)
+	{
+		if(n >= root + bit)
+		{
+			n -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (int)root;
+}
+
+bool InPaddleZone(int num) // Is the ball low enough that it could touch the paddle or fall off the board
+{
+	return game->balls[num].y + GetBallShape(game->balls[num].size).maxY + 1 > (TILESIZE*GAMEHEIGHT-1) - (TILESIZE*2 - 2);
+}
+
+int ClearStepsX(int num, int dirX) // Number of horizontal steps the ball can take without touching anything
+{
+	const BallShape &shape = GetBallShape(game->balls[num].size);
+	int border; // Steps before a border is reached
+	int brick; // Steps before a leading edge crosses into the next column of bricks
+
+	if(InPaddleZone(num)) // Near the paddle every step is checked
+	{
+		return 0;
+	}
+	if(dirX > 0)
+	{
+		border = (TILESIZE*GAMEWIDTH-1) - TILESIZE - game->balls[num].x - shape.maxX;
+		brick = StepsToCrossing(shape.crossRight, game->balls[num].x & 15);
+	}
+	else
+	{
+		border = game->balls[num].x + shape.minX - TILESIZE;
+		brick = StepsToCrossing(shape.crossLeft, -game->balls[num].x & 15);
+	}
+	if(brick < border)
+	{
+		border = brick;
+	}
+	return border > 0 ? border : 0;
+}
+
+int ClearStepsY(int num, int dirY) // Number of vertical steps the ball can take without touching anything
+{
+	const BallShape &shape = GetBallShape(game->balls[num].size);
+	int border; // Steps before the top border or the paddle is reached
+	int brick; // Steps before a leading edge crosses into the next row of bricks
+
+	if(InPaddleZone(num)) // Near the paddle every step is checked
+	{
+		return 0;
+	}
+	if(dirY > 0)
+	{
+		border = (TILESIZE*GAMEHEIGHT-1) - (TILESIZE*2 - 2) - game->balls[num].y - shape.maxY;
+		brick = StepsToCrossing(shape.crossDown, game->balls[num].y & 15);
+	}
+	else
+	{
+		border = game->balls[num].y + shape.minY - TILESIZE;
+		brick = StepsToCrossing(shape.crossUp, -game->balls[num].y & 15);
+	}
+	if(brick < border)
+	{
+		border = brick;
+	}
+	return border > 0 ? border : 0;
+}
+
+bool BallOverlapsBricks(int num) // Does any pixel of the ball lie inside a brick
+{
+	const BallShape &shape = GetBallShape(game->balls[num].size);
+	int y; // Counter
+
+	for(y = shape.minY; y <= shape.maxY; y++)
+	{
+		if(shape.rows[y] & BrickRowMask(game->balls[num].x, game->balls[num].y + y))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool BallMoveClear(int num, int moveX, int moveY) // Can the ball move moveX,moveY 1/256ths of a pixel without touching anything
+{
+	// The broad phase, looks at the box the ball sweeps through this update against the board borders,
+	// the rows the paddle is on and the brick grid, so only balls near something are swept step by step
+	const BallShape &shape = GetBallShape(game->balls[num].size);
+	int endX = game->balls[num].x + ((game->balls[num].subX + moveX) >> 8); // Pixel the ball ends up on (SUBPIXELS is 256)
+	int endY = game->balls[num].y + ((game->balls[num].subY + moveY) >> 8);
+	int left = (endX < game->balls[num].x ? endX : game->balls[num].x) + shape.minX; // The box of pixels swept through
+	int right = (endX > game->balls[num].x ? endX : game->balls[num].x) + shape.maxX;
+	int top = (endY < game->balls[num].y ? endY : game->balls[num].y) + shape.minY;
+	int bottom = (endY > game->balls[num].y ? endY : game->balls[num].y) + shape.maxY;
+	unsigned long long columns; // The brick columns the box covers
+	int row; // Counter
+
+	// Clear of the borders, and above the paddle so it can't be hit or the ball lost
+	if(left < TILESIZE || right > (TILESIZE*GAMEWIDTH-1) - TILESIZE || top < TILESIZE ||
+		bottom > (TILESIZE*GAMEHEIGHT-1) - (TILESIZE*2 - 2))
+	{
+		return false;
+	}
+
+	// Clear of every brick in the cells of the grid the box covers
+	columns = (2ULL << (right/BRICKSIZE)) - (1ULL << (left/BRICKSIZE));
+	for(row = top/BRICKSIZE; row <= bottom/BRICKSIZE; row++)
+	{
+		if(BrickRow(row) & columns)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void SweepBall(int num) // Move a ball one game update, checking only the steps where it could touch something
+{
+	// The ball moves along a straight line in fixed point, taking a pixel step on an axis each time the line
+	// crosses into the next pixel, with the steps on the two axes in the order the line crosses them
+	// A ball that isn't inside a brick can only hit one when a leading edge crosses into the next
+	// brick row or column, so the steps in between are jumped over and only the crossing steps,
+	// the borders and the paddle area are checked pixel by pixel with CollisionCheck
+	int moveX = TickShare(game->balls[num].speedX); // 1/256ths of a pixel to move horizontally this update
+	int moveY = TickShare(game->balls[num].speedY); // 1/256ths of a pixel to move vertically this update
+	int dirX = moveX > 0 ? 1 : -1; // X direction
+	int dirY = moveY > 0 ? 1 : -1; // Y direction
+	int distX = abs(moveX); // Distance to move horizontally
+	int distY = abs(moveY); // Distance to move vertically
+	int firstX = FirstCrossing(game->balls[num].subX, dirX); // Distance before the first horizontal pixel step
+	int firstY = FirstCrossing(game->balls[num].subY, dirY); // Distance before the first vertical pixel step
+	int stepsX = StepsWithin(distX, firstX); // Horizontal pixel steps this update
+	int stepsY = StepsWithin(distY, firstY); // Vertical pixel steps this update
+	int doneX = 0, doneY = 0; // Steps taken so far on each axis
+	int clearX, clearY; // Steps on each axis that can't touch anything
+	int nextX, nextY; // Steps on each axis taken by the end of the jump
+	bool checkAll; // Every step needs checking
+
+	if(distX == 0 && distY == 0) // A ball with no speed doesn't move
+	{
+		return;
+	}
+
+	if(game->broadPhase && BallMoveClear(num, moveX, moveY)) // If nothing is anywhere near the ball's path...
+	{
+		// Make the whole move in one go
+		game->balls[num].x += (game->balls[num].subX + moveX) >> 8;
+		game->balls[num].y += (game->balls[num].subY + moveY) >> 8;
+		game->balls[num].subX = (game->balls[num].subX + moveX) & (SUBPIXELS - 1);
+		game->balls[num].subY = (game->balls[num].subY + moveY) & (SUBPIXELS - 1);
+		return;
+	}
+
+	checkAll = BallOverlapsBricks(num); // Inside a brick the leading edges can't be trusted
+
+	while(doneX < stepsX || doneY < stepsY)
+	{
+		// Find the first step on either axis that could touch something
+		nextX = doneX;
+		nextY = doneY;
+		if(!checkAll)
+		{
+			clearX = doneX + ClearStepsX(num, dirX);
+			clearY = doneY + ClearStepsY(num, dirY);
+			if(clearX >= stepsX && clearY >= stepsY) // If nothing can be touched this update...
+			{
+				nextX = stepsX;
+				nextY = stepsY;
+			}
+			else if(clearY >= stepsY || (clearX < stepsX && StepXFirst(clearX + 1, clearY + 1, firstX, firstY, distX, distY)))
+			{
+				// A horizontal step comes first, go up to it along with the vertical steps before it
+				nextX = clearX;
+				nextY = StepsWithin(((long long)(firstX + SUBPIXELS*clearX) * distY - 1) / distX, firstY);
+			}
+			else
+			{
+				// A vertical step comes first, go up to it along with the horizontal steps before it
+				nextY = clearY;
+				nextX = StepsWithin((long long)(firstY + SUBPIXELS*clearY) * distX / distY, firstX);
+			}
+		}
+
+		// Jump straight to it
+		game->balls[num].x += dirX * (nextX - doneX);
+		game->balls[num].y += dirY * (nextY - doneY);
+		doneX = nextX;
+		doneY = nextY;
+		if(doneX == stepsX && doneY == stepsY) // If the ball moved its full speed for this update...
+		{
+			break;
+		}
+
+		// Check that step
+		if(doneY == stepsY || (doneX < stepsX && StepXFirst(doneX + 1, doneY + 1, firstX, firstY, distX, distY)))
+		{
+			if(CollisionCheck(num, dirX, 0)) // collision check x...
+			{
+				return; // The ball stops for this update
+			}
+			game->balls[num].x += dirX; // move
+			doneX++;
+		}
+		else
+		{
+			if(CollisionCheck(num, 0, dirY)) // collision check y...
+			{
+				return; // The ball stops for this update
+			}
+			game->balls[num].y += dirY; // move
+			doneY++;
+		}
+	}
+
+	// The ball made its full move, so carry how far through its pixel it is on to the next update
+	game->balls[num].subX = (game->balls[num].subX + moveX) & (SUBPIXELS - 1);
+	game->balls[num].subY = (game->balls[num].subY + moveY) & (SUBPIXELS - 1);
+}
+
+bool LoadLevel(int num) // Load level num from the level table
+{
+	const PackLevel *level = FindPackLevel(num); // The level as it was read from the levels file
+	int x, y; // Counters
+	int powerup; // Determines the powerup to be assigned to a block
+	int style, colour; // The style and colour of the brick being placed
+
+	if(level == NULL) // If the levels file doesn't have it...
+	{
+		return false; // Level wasn't loaded
+	}
+
+	// Fill the brick grid with the level data
+	ResetNumBricks(); // Reset the number of bricks in the level to zero;
+	for(y = 0; y < BGAMEHEIGHT; y++)
+	{
+		for(x = 0; x < BGAMEWIDTH; x++)
+		{
+			style = level->style[x][y];
+			colour = level->colour[x][y];
+			SetBrick(x, y, style, colour); // Place the brick in the current position of the level map
+			SetBrickExplosive(x, y, level->explosive[x][y]);
+
+			// If there is a brick and it's not grey. Grey bricks don't count towards finishing a level
+			if(style != 0 && colour > 1)
+			{
+				ChangeNumBricks(1); // Count another brick to be knocked out to complete the level
+			}
+
+			// The powerup coins are picked as each game loads the level, from its own random stream
+			// Deciding whether a block gets a powerup coin
+			SetBrickPowerup(x, y, 0); // Default for all brick locations is zero
+			
+			// Check there is a brick and it's not grey. Grey bricks don't get powerup coins
+			if(style != 0 && colour > 1)
+			{
+				if( !GameRandom(RANDOM_LEVEL, POWERUPCHANCE) ) // 1 in POWERUPCHANCE chance for a block to have a powerup
+				{
+					/* Various powerup chances
+					Extra Life	1
+					Guns		4
+					Fireball	10
+					Explosive	10
+					Magnetic	25
+					Extra Ball	25
+					PSize+		25
+					PSpeed+		25
+					BSize+		25
+					PSize-		25
+					PSpeed-		25
+					BSize-		50
+
+					Total 250
+					*/
+					powerup = GameRandom(RANDOM_LEVEL, 250); // Random number that will determine the powerup
+
+					if(powerup < 50) // 1 in 5 chance for a decrease ball size token
+					{
+						SetBrickPowerup(x, y, DECBALLSIZE);
+					}
+					else if (powerup < 75) // 1 in 10 chance for a decrease paddle size token
+					{
+						SetBrickPowerup(x, y, DECPADDLESPEED);
+					}
+					else if (powerup < 100) // 1 in 10 chance for a decrease paddle speed token
+					{
+						SetBrickPowerup(x, y, DECPADDLESIZE);
+					}
+					else if (powerup < 125) // 1 in 10 chance for a increase ball size token
+					{
+						SetBrickPowerup(x, y, INCBALLSIZE);
+					}
+					else if (powerup < 150) // 1 in 10 chance for a increase paddle size token
+					{
+						SetBrickPowerup(x, y, INCPADDLESPEED);
+					}
+					else if (powerup < 175) // 1 in 10 chance for a increase paddle speed token
+					{
+						SetBrickPowerup(x, y, INCPADDLESIZE);
+					}
+					else if (powerup < 200) // 1 in 10 chance for an extra ball token
+					{
+						SetBrickPowerup(x, y, EXTRABALL);
+					}
+					else if (powerup < 225) // 1 in 10 chance for a magnetic coin
+					{
+						SetBrickPowerup(x, y, MAGNETIC);
+					}
+					else if (powerup < 235) // 1 in 25 chance for an explosive ball token
+					{
+						SetBrickPowerup(x, y, EXPLOSIVE);
+					}
+					else if (powerup < 245) // 1 in 25 chance for a fireball ball token
+					{
+						SetBrickPowerup(x, y, FIREBALL);
+					}
+					else if (powerup < 249) // 2 in 125 chance for a gun token
+					{
+						SetBrickPowerup(x, y, GUNS);
+					}
+					else if (powerup < 250) // 1 in 250 chance for an extra life token
+					{
+						SetBrickPowerup(x, y, EXTRALIFE);
+					}
+					else
+					{
+						SetBrickPowerup(x, y, 0);
+					}
+				}
+			}
+		}
+	}
+
+	ClearCoins(); // Clear any coins that are falling
+	ClearMessages(); // Clear the message queue
+	return true; // Level was loaded
+}
+
+void SetPaddleDirection(int num) // Set the direction the paddle is moving
+{
+	if(num > 0) // If the movement change is positive...
+	{
+		game->paddleDirection = 1; // Set the paddle to move right
+	}
+	else if(num < 0) // If the movement change is negative...
+	{
+		game->paddleDirection = -1; // Set the paddle to move left
+	} else
+	{
+		game->paddleDirection = 0; // Otherwise stop the paddle
+	}
+	return;
+}
+
+int GetPaddleDirection() // Gives the direction the paddle is moving
+{
+	return game->paddleDirection;
+}
+
+void ChangeLevel(int num) // Change the level
+{
+	int tempLevel; // Used to hold the new level number till it's confirmed to be found
+	// int n; // Counter
+
+	ClearBricks(); // Reset the level map
+	
+	// The level we want to change to
+	tempLevel = game->level + num;
+
+	while(tempLevel < 1) // If the new level is less than level 1...
+	{		
+		if(GetScoreMultiplier() == 1) // If the score multiplier is at it's lowest...
+		{
+			tempLevel = 1; // Set the level to 1
+		}
+		else // If the multiplier has been increased...
+		{
+			tempLevel += GetMaxLevel(); // Cycle back to the last level
+			ChangeScoreMultiplier(-1); // And decrease the score multiplier
+		}
+	}
+	
+	while(tempLevel > GetMaxLevel()) // If the new level is greater than the number of levels
+	{
+		tempLevel -= GetMaxLevel(); // Cycle back to the first level
+		ChangeScoreMultiplier(1); // And increase the score multiplier
+	}
+
+	if(LoadLevel(tempLevel)) // Load the new level and if it loaded...
+	{
+		game->level = tempLevel; // Make the level change permanent
+	}
+	else // If it failed to load...
+	{
+		LoadLevel(1); // Load level 1
+	}
+	
+	game->paddleSize = 8; // Reset the paddle size
+	game->paddleSpeed = 4; // Reset the paddle speed
+
+	game->magnetic = 0; // Remove magnetic
+
+	game->levelComplete = false; // The new level has all its bricks
+	PostEvent(EVENT_LEVELSTARTED, !game->gamePaused, 0, 0, game->level);
+
+	// Reset the balls using the UseLife() function
+	if(GetLife() == 5) // If we have the maximum number of lives already...
+	{
+		UseLife(); // We use a life first
+		AddLife(); // Then add the life back
+	}
+	else // If we don't have the maximum number of lives...
+	{
+		AddLife(); // We add the life first to ensure we don't accidentally end the game
+		UseLife(); // Then we use the life
+	}
+
+	ResetExplosions(); // Remove all explosions
+	ResetBullets(); // Reset all bullets
+
+	if(game->gameHooks.levelLoaded) // If the front end wants to know about new levels...
+	{
+		game->gameHooks.levelLoaded(game->level); // Let it load the new background, reset its timer and redraw
+	}
+}
+
+int GetLevel() // Gives the current level
+{
+	return game->level;
+}
+
+void LoadLevelPack() // Read the levels file into the level table, with the number of levels and brick styles, and hash it
+{
+	// The file is read once here and only the table is read as the games load their levels, so any number of
+	// games on any number of threads can load levels at once without touching the file
+	// Each marker is looked for through the whole file a character at a time, as it was when the file was
+	// read for each of them, so the same file gives the same levels
+	std::string text; // Every character of the file
+	char buffer[4096]; // Characters read in one go
+	size_t count; // Number of them
+	size_t pos; // Next character of the file to look at
+	size_t at; // Next character of a level's bricks
+	int ch; // The character being looked at
+	int brick; // A character of a level's bricks
+	int x, y; // Counters
+	FILE *levelFile; // File to read the level data from
+	PackLevel level; // The level being read
+
+	levelFile = fopen("Levels.txt", "r");  // Open Levels.txt for reading
+	levelPackHash = 0; // No levels file
+	levelPack.clear(); // No levels
+
+	if(levelFile == NULL) // Check that the file opened
+	{
+		return;
+	}
+	while((count = fread(buffer, 1, sizeof(buffer), levelFile)) > 0)
+	{
+		text.append(buffer, count);
+	}
+	fclose(levelFile); // Close the level file
+
+	levelPackHash = 2166136261u; // Hash every character of the file (FNV-1a)
+	for(pos = 0; pos < text.size(); pos++)
+	{
+		levelPackHash = (levelPackHash ^ (unsigned char)text[pos]) * 16777619u;
+	}
+
+	// Find the max level marker
+	pos = 0;
+	do {
+		ch = PackCharacter(text, pos);
+		if(ch == 'M')
+		{
+			maxLevel = PackNumber(text, pos, ch, '\n', '\n'); // The rest of the line
+			if (maxLevel < 1) // If the max level is less than one...
+			{
+				maxLevel = 1; // Make the max level equal to one
+			}
+		}
+	} while (ch != EOF);
+
+	// Find the brick styles marker
+	pos = 0;
+	do {
+		ch = PackCharacter(text, pos);
+		if(ch == 'B')
+		{
+			brickStyles = PackNumber(text, pos, ch, '\n', '\n'); // The rest of the line
+			if (brickStyles < 1) // If the brick styles are less than one...
+			{
+				brickStyles = 1; // Make the brick styles equal to one
+			}
+		}
+	} while (ch != EOF);
+
+	// Read the bricks after each level marker, "(style,colour)" or "(style,colour,1)" for a brick that explodes
+	pos = 0;
+	do {
+		ch = PackCharacter(text, pos);
+		if(ch == 'L')
+		{
+			level.id = PackNumber(text, pos, ch, '\n', '\n'); // The rest of the line
+			at = pos; // The search for the next marker carries on from the end of the line
+			for(y = 0; y < BGAMEHEIGHT; y++)
+			{
+				for(x = 0; x < BGAMEWIDTH; x++)
+				{
+					do { // Skip through the file till the next open bracket
+						brick = PackCharacter(text, at);
+					} while(brick != '(' && brick != EOF);
+					level.style[x][y] = PackNumber(text, at, brick, ',', ',');
+					level.colour[x][y] = PackNumber(text, at, brick, ')', ',');
+					level.explosive[x][y] = brick == ',' && PackNumber(text, at, brick, ')', ')') == 1;
+				}
+			}
+			levelPack.push_back(level);
+		}
+	} while (ch != EOF);
+}
+
+const PackLevel *FindPackLevel(int num) // Returns level num of the level table (NULL = it isn't in the levels file)
+{
+	size_t n; // Counter
+
+	for(n = 0; n < levelPack.size(); n++)
+	{
+		if(levelPack[n].id == num) // The first level with the number is the one played
+		{
+			return &levelPack[n];
+		}
+	}
+	return NULL;
+}
+
+int PackCharacter(const std::string &text, size_t &pos) // Returns the next character of the levels file (EOF at the end)
+{
+	if(pos >= text.size())
+	{
+		return EOF;
+	}
+	return (unsigned char)text[pos++];
+}
+
+int PackNumber(const std::string &text, size_t &pos, int &ch, int end1, int end2) // Reads the characters of the levels file up to end1 or end2 as a number, ch is left on the one it stopped at
+{
+	std::string digits; // The characters of the number
+
+	ch = PackCharacter(text, pos);
+	while(ch != end1 && ch != end2 && ch != EOF)
+	{
+		digits += (char)ch;
+		ch = PackCharacter(text, pos);
+	}
+	return atoi(digits.c_str());
+}
+
+int GetMaxLevel() // Gives the maximum level number
+{
+	return maxLevel;
+}
+
+PaddleBounds GetPaddleBounds() // Returns where the paddle is and the profiles a ball sees it through
+{
+	PaddleBounds paddle;
+
+	paddle.left = GetPaddlePosition();
+	paddle.across = &GetPaddleProfile(PADDLEPROFILE_ACROSS, GetPaddleSize());
+	paddle.down = &GetPaddleProfile(PADDLEPROFILE_DOWN, GetPaddleSize());
+	return paddle;
+}
+
+void PaddleRebound(int num) // The ball hit the paddle, so stick it or send it back up
+{
+	game->balls[num].bricks = 1; // Reset the brick mulitplier for this ball
+	PostEvent(EVENT_REBOUND, REBOUND_PADDLE, game->balls[num].x, game->balls[num].y, 0); // Play the sound for hitting the paddle
+	if(game->magnetic) // If the paddle is currently magnetic...
+	{
+		game->balls[num].stuck = true; // The ball sticks to the paddle
+		game->balls[num].speedX = 0; // The ball stops moving horizontally
+		game->balls[num].speedY = 0; // The ball stops moving vertically
+	}
+	else // If the paddle is not currently magnetic...
+	{
+		ReleaseBall(num); // Rebound the ball in a direction depending on where it hit the paddle
+	}
+}
+
+void HitBrick(int num, int brickX, int brickY, int normalX, int normalY) // The ball hit the brick at brickX,brickY on its side facing normalX,normalY
+{
+	int powerup; // The powerup coin of a knocked out brick
+	bool grey = BrickColour(brickX, brickY) == 1; // Grey bricks don't score and only the biggest balls knock them out
+	bool explosiveBrick = BrickExplosive(brickX, brickY); // Does the brick set off an explosion when knocked out
+
+	// If it is a grey brick...
+	if(grey)
+	{
+		// If the the ball isn't big enough to knockout a grey brick...
+		if(game->balls[num].size < KNOCKOUTBALLSIZE && game->balls[num].greyBricks < GREYLOOPREBOUNDS)
+		{ // Grey brick isn't knocked out
+			ReflectBall(num, normalX, normalY); // Bounce the ball off the brick
+			PostEvent(EVENT_REBOUND, REBOUND_BRICK, brickX*BRICKSIZE, brickY*BRICKSIZE, 0); // Play the sound for rebounding off a brick
+			game->balls[num].greyBricks++; // Increment the grey brick counter
+			return;
+		}
+		// If the ball is big enough to knockout a grey brick...
+		// No score for grey bricks
+		PostEvent(EVENT_BRICKDESTROYED, CAUSE_BALL, brickX*BRICKSIZE, brickY*BRICKSIZE, 0); // Play the sound for knocking out a brick
+		if(game->balls[num].size < KNOCKOUTBALLSIZE) // If it was only let through to stop it rebounding off grey bricks for ever...
+		{
+			PostEvent(EVENT_GREYLOOPBROKEN, 0, brickX*BRICKSIZE, brickY*BRICKSIZE, game->balls[num].greyBricks);
+		}
+	}
+	else // If it is not a grey brick...
+	{
+		// Add points based on the type of brick that was knocked out and active multipliers, and play the sound
+		PostEvent(EVENT_BRICKDESTROYED, CAUSE_BALL, brickX*BRICKSIZE, brickY*BRICKSIZE,
+			BrickPoints(BrickStyle(brickX, brickY), BrickColour(brickX, brickY), game->balls[num].bricks));
+
+		if(ChangeNumBricks(-1)) // Reduce the number of bricks required to clear the level
+		{
+			return; // The level is complete, the ball will be reset
+		}
+	}
+
+	// Remove the brick from the level map
+	RemoveBrick(brickX, brickY);
+
+	// If there was a powerup coin attached to the brick...
+	// (Shouldn't be for grey bricks, but code is added anyway incase it's changed)
+	powerup = TakeBrickPowerup(brickX, brickY); // Take any powerup coin off the brick
+	if(powerup)
+	{
+		// Create the powerup coin to the game in place of the brick
+		AddCoin(powerup, brickX*BRICKSIZE, brickY*BRICKSIZE);
+	}
+
+	if(!game->balls[num].fire) // If it not a fireball...
+	{
+		ReflectBall(num, normalX, normalY); // Bounce the ball off the brick
+	}
+	if(game->balls[num].explosive || explosiveBrick) // If the ball or the brick is explosive...
+	{
+		// Knock out extra bricks based on the size of the ball, and around any explosive bricks
+		ExplodeBrick(num, brickX, brickY, explosiveBrick);
+	}
+	if(!grey)
+	{
+		game->balls[num].bricks++; // Increase the brick score multiplier for the ball
+	}
+	game->balls[num].greyBricks = 0; // Reset the grey brick counter
+}
+
+// Checks whether a ball will hit an object if it moves one pixel in direction MOVEX,MOVEY
+// Each direction is built from this one kernel with the direction fixed, so the tests that can't happen
+// in that direction (the top border moving down, the paddle moving up...) are left out altogether
+template<int MOVEX, int MOVEY>
+bool CollisionKernel(int num, const PaddleBounds &paddle)
+{
+	// Check order: Borders, Paddle, Bricks
+	// Moving down the columns are checked from the bottom up, otherwise the rows are checked
+	// from the leading side back
+	const bool byColumn = MOVEY > 0; // Check the ball column by column
+	const bool highFirst = MOVEX > 0 || MOVEY > 0; // Check the highest pixel in each row or column first
+	const BallShape &shape = GetBallShape(game->balls[num].size); // The pixel masks of the ball
+	int line; // The row or column being checked
+	int pixel; // The pixel in the row or column being checked
+	int px, py; // Where the pixel moves to
+	unsigned int candidates; // Pixels in the current row or column still to be checked
+
+	for(line = 0; line < 16; line++)
+	{
+		// Only check the pixels that could hit a border, the paddle or a brick
+		if(byColumn)
+		{
+			candidates = shape.columns[line] ? shape.columns[line] & ColumnContacts(num, line, MOVEY) : 0;
+		}
+		else
+		{
+			candidates = shape.rows[line] ? shape.rows[line] & RowContacts(num, line, MOVEX, MOVEY) : 0;
+		}
+		while(candidates)
+		{
+			if(highFirst)
+			{
+				pixel = HighestBit(candidates);
+				candidates &= ~(1u << pixel); // Remove the pixel from the list
+			}
+			else
+			{
+				pixel = LowestBit(candidates);
+				candidates &= candidates - 1; // Remove the pixel from the list
+			}
+			px = game->balls[num].x + (byColumn ? line : pixel) + MOVEX;
+			py = game->balls[num].y + (byColumn ? pixel : line) + MOVEY;
+
+			// If the ball hits a border...
+			if((MOVEX < 0 && px < TILESIZE) ||
+				(MOVEX > 0 && px > (TILESIZE*GAMEWIDTH-1) - TILESIZE) ||
+				(MOVEY < 0 && py < TILESIZE))
+			{
+				ReflectBall(num, MOVEX != 0, MOVEY != 0); // Reverse the ball's speed on the axis it's moving along
+				PostEvent(EVENT_REBOUND, REBOUND_BORDER, px, py, 0); // Play the sound for hitting a border
+				return true; // Collision occured and was resolved
+			}
+
+			// If the ball hits the paddle...
+			if(MOVEY >= 0 && game->balls[num].noRebound <= 0 && OnPaddle(MOVEY > 0 ? *paddle.down : *paddle.across, paddle.left, px, py))
+			{
+				PaddleRebound(num);
+				return true; // Collision occured and was resolved
+			}
+
+			// If the ball hits a brick...
+			if(BrickAt(px/BRICKSIZE, py/BRICKSIZE))
+			{
+				HitBrick(num, px/BRICKSIZE, py/BRICKSIZE, MOVEX != 0, MOVEY != 0);
+				return true; // Collision occured and was resolved
+			}
+		}
+	}
+
+	// If the ball is lost...
+	if(MOVEY > 0 && game->balls[num].y > (TILESIZE*GAMEHEIGHT-1))
+	{
+		LoseBall(num); // Remove the ball
+		return true; // Collision occured and was resolved
+	}
+	return false; // No collision detected
+}
+
+bool CollisionCheck(int num, int moveX, int moveY) // Checks whether a ball will hit an object if it moves
+{
+	PaddleBounds paddle = GetPaddleBounds(); // The paddle doesn't move while the ball does
+
+	if(moveX == -1 && CollisionKernel<-1, 0>(num, paddle)) // Moving left
+	{
+		return true;
+	}
+	if(moveX == 1 && CollisionKernel<1, 0>(num, paddle)) // Moving right
+	{
+		return true;
+	}
+	if(moveY == -1 && CollisionKernel<0, -1>(num, paddle)) // Moving up
+	{
+		return true;
+	}
+	if(moveY == 1 && CollisionKernel<0, 1>(num, paddle)) // Moving down
+	{
+		return true;
+	}
+	return false; // No collision detected
+}
+
+unsigned int PixelRangeMask(int first, int last) // Returns a mask with bits first to last set, clipped to the 16 pixels of a ball
+{
+	if(first < 0)
+	{
+		first = 0;
+	}
+	if(last > 15)
+	{
+		last = 15;
+	}
+	if(first > last) // If none of the range is on the ball...
+	{
+		return 0;
+	}
+	return ((2u << last) - 1) & ~((1u << first) - 1);
+}
+
+unsigned int BrickRowMask(int px, int py) // Returns a mask with bit x set if pixel px+x,py is inside a brick
+{
+	int column = px / BRICKSIZE; // Brick column under the first pixel
+	int row = py / BRICKSIZE; // Brick row under the pixels
+	unsigned int first = (1u << (BRICKSIZE - px % BRICKSIZE)) - 1; // Pixels that lie in the first brick column
+	unsigned int mask = 0;
+	unsigned int pair; // The brick under the first pixel and the one after it
+
+	if(px < 0 || column >= BGAMEWIDTH) // If the row is off the board...
+	{
+		return 0;
+	}
+	pair = (unsigned int)(BrickRow(row) >> column) & 3;
+	if(pair & 1)
+	{
+		mask |= first;
+	}
+	if(pair & 2)
+	{
+		mask |= ~first & 0xFFFF; // The rest of the 16 pixels lie in the next brick column
+	}
+	return mask;
+}
+
+unsigned int BrickColumnMask(int px, int py) // Returns a mask with bit y set if pixel px,py+y is inside a brick
+{
+	int column = px / BRICKSIZE; // Brick column under the pixels
+	int row = py / BRICKSIZE; // Brick row under the first pixel
+	unsigned int first = (1u << (BRICKSIZE - py % BRICKSIZE)) - 1; // Pixels that lie in the first brick row
+	unsigned int mask = 0;
+	unsigned int pair; // The brick under the first pixel and the one after it
+
+	if(py < 0 || row > BGAMEHEIGHT) // If the column is off the board...
+	{
+		return 0;
+	}
+	pair = (BrickColumn(column) >> row) & 3;
+	if(pair & 1)
+	{
+		mask |= first;
+	}
+	if(pair & 2)
+	{
+		mask |= ~first & 0xFFFF; // The rest of the 16 pixels lie in the next brick row
+	}
+	return mask;
+}
+
+unsigned int RowContacts(int num, int y, int moveX, int moveY) // Returns the pixels in row y of a ball that could hit something if it moves
+{
+	int px = game->balls[num].x + moveX; // Where the first pixel of the row moves to
+	int py = game->balls[num].y + y + moveY; // Where the row moves to
+	unsigned int mask; // Pixels that need checking
+
+	// Pixels that move into the side borders
+	mask = PixelRangeMask(0, TILESIZE - 1 - px);
+	mask |= PixelRangeMask((TILESIZE*GAMEWIDTH-1) - TILESIZE + 1 - px, 15);
+
+	// The whole row if it moves into the top border
+	if(py < TILESIZE)
+	{
+		mask = 0xFFFF;
+	}
+
+	// The whole row if it's in line with the paddle
+	const PaddleProfile &across = GetPaddleProfile(PADDLEPROFILE_ACROSS, GetPaddleSize());
+	if(game->balls[num].noRebound <= 0 && py >= across.top && py < across.top + across.rows)
+	{
+		mask = 0xFFFF;
+	}
+
+	return mask | BrickRowMask(px, py); // Pixels that move into a brick
+}
+
+unsigned int ColumnContacts(int num, int x, int moveY) // Returns the pixels in column x of a ball that could hit something if it moves
+{
+	int px = game->balls[num].x + x; // Where the column moves to
+	int py = game->balls[num].y + moveY; // Where the first pixel of the column moves to
+	unsigned int mask = 0; // Pixels that need checking
+
+	// Pixels that move in line with the paddle
+	if(game->balls[num].noRebound <= 0)
+	{
+		const PaddleProfile &down = GetPaddleProfile(PADDLEPROFILE_DOWN, GetPaddleSize());
+		mask = PixelRangeMask(down.top - py, down.top + down.rows - 1 - py);
+	}
+
+	return mask | BrickColumnMask(px, py); // Pixels that move into a brick
+}
+
+void AdjustBallSize(int num, int sizeChange) // Adjust the size of the given ball
+{
+	if(sizeChange > 0) // If the change in positive...
+	{
+		game->balls[num].size++; // Increase the ball's size by one
+	}
+	if(sizeChange < 0) // If the change in negative...
+	{
+		game->balls[num].size--; // Decrease the ball's size by one
+	}
+	if(sizeChange != 0) // If the change is not neutral...
+	{
+		if(game->balls[num].size > 7) // If the new ball size is above seven...
+		{
+			game->balls[num].size = 7; // The ball size is seven
+		}
+		if(game->balls[num].size < 1) // If the new ball size is below one
+		{
+			game->balls[num].size = 1; // The new ball size is one
+		}
+	}
+
+	// The ball's pixels come from the shared shape for its size, so there is no pixel map to rebuild
+	return;
+}
+
+void LoseBall(int num) // Removes the given ball from the game
+{
+	game->balls.Remove(num); // The last ball takes its place
+
+	if(game->balls.Count() == 0) // If there are no balls left...
+	{
+		if(game->livesRemaining > 0) // If there is a life to use...
+		{
+			PostEvent(EVENT_LIFELOST, 0, 0, 0, game->livesRemaining); // Play the sound for losing a life
+		}
+		UseLife(); // Lose a life
+	}
+}
+
+void AddBall() // Adds a new ball if there is room
+{
+	int n; // The new ball
+
+	n = game->balls.Add();
+	if(n != -1) // If there was room...
+	{
+		// Initilize and release the new ball
+		game->balls[n].size = 4;
+		game->balls[n].x = GetPaddlePosition() + GameRandom(RANDOM_PLAY, (GetPaddleSize()+2)*8-TILESIZE); // Random position on the paddle
+		game->balls[n].y = 479 - 14 - (9+(game->balls[n].size));
+		game->balls[n].speedX = 0;
+		game->balls[n].speedY = 0;
+		game->balls[n].subX = SUBPIXELS/2; // Start in the middle of the pixel
+		game->balls[n].subY = SUBPIXELS/2;
+		game->balls[n].speedMod = 0;
+		game->balls[n].stuck = true;
+		game->balls[n].fire = 0;
+		game->balls[n].explosive = 0;
+		game->balls[n].noRebound = 0;
+		game->balls[n].bricks = 0;
+		game->balls[n].greyBricks = 0;
+		game->balls[n].lastX = game->balls[n].x; // Don't draw the ball sliding in from another ball's old position
+		game->balls[n].lastY = game->balls[n].y;
+		ReleaseBall(n); // Sends the ball in a direction based on its position on the paddle
+	}
+}
+
+void AddLife() // Adds a life if there aren't too many already
+{
+	if(game->livesRemaining < 5) // If the player has less then 5 extra lives...
+	{
+		game->livesRemaining++; // Add an extra life
+	}
+	return;
+}
+
+int GetLife() // Gives the number of extra lives a player has
+{
+	return game->livesRemaining;
+}
+
+void ResetNumBricks() // Resets the number of bricks left on a level to zero
+{
+	game->numBricks = 0; // Set the number of bricks left to zero
+}
+
+bool ChangeNumBricks(int num) // Changes the number of bricks left in the level
+{
+	game->numBricks += num; // Add the given change to the number of remaining bricks
+
+	if(game->numBricks < 1) // If there are no bricks left to knock out...
+	{
+		game->levelComplete = true; // Go to the next level once the game update has finished
+		return true; // Report level complete
+	}
+	return false; // Report no change
+}
+
+int GetNumBricks() // Gives the number of bricks left to complete the level
+{
+	return game->numBricks;
+}
+
+void UnpauseGame() // Unpause the game
+{
+	game->gamePaused = 0; // Unpause the game
+}
+
+int GetPausedGame() // Gives the number of the help screen to be shown when paused
+{
+	return game->gamePaused;
+}
+
+int GetScore() // Gives the score
+{
+	return game->score;
+}
+
+int BrickPoints(int x, int y, int brickMultiplier) // Returns the score for a brick based on the brick type, level and multipliers
+{
+	// Worked out when the brick is knocked out, as the level and score multiplier can change before the score is added up
+	return x * (y + GetLevel()) * (brickMultiplier/5 + 1) * GetScoreMultiplier();
+}
+
+int GetScoreMultiplier() // Gives the current score mulitplier
+{
+	return game->scoreMultiplier;
+}
+
+void ChangeScoreMultiplier(int num) // Changes the score multiplier
+{
+	game->scoreMultiplier += num; // Add the given value to the score multiplier
+
+	if(game->scoreMultiplier < 1) // If the score multiplier goes below one...
+	{
+		game->scoreMultiplier = 1; // The score multiplier is one
+	}
+	if(game->scoreMultiplier > 1000) // If the score multiplier goes above one thousand...
+	{
+		game->scoreMultiplier = 1000; // The score multiplier is one thousand
+	}
+}
+
+void ClearCoins() // Clears all the falling coins
+{
+	game->coins.Clear(); // Remove all the coins
+}
+
+void DropCoins() // Move all the coin down and check for collision
+{
+	int n; // Counter
+	int x, y; // More counters
+	bool collectedCoin; // Set to true if the coin gets collected
+
+	n = 0;
+	while(n < game->coins.Count()) // Cycle through the coins
+	{
+		collectedCoin = false; // This coin is not collected yet
+
+		game->coins[n].rotationPos++; // Increase the rotation
+
+		if(game->coins[n].rotationPos >= (8 * ScaleTicks(COINSPEED))) // If the coin has gone through all the rotations
+		{
+			game->coins[n].rotationPos = game->coins[n].rotationPos - (8 * ScaleTicks(COINSPEED)); // Cycle back to the first rotation
+		}
+
+		if(game->coins[n].y + COINDROP >= GAMEHEIGHT*TILESIZE - 32) // If the coin is low enough to hit the paddle...
+		{
+			// Looked up for each coin as an earlier coin may have changed the paddle size
+			const PaddleProfile &coin = GetPaddleProfile(PADDLEPROFILE_COIN, GetPaddleSize()); // The paddle as seen by a falling coin
+
+			for(x = 0; x < 16; x++) // Check each column of the coins pixel map
+			{
+				y = CoinBottom(game->coins[n].rotationPos/ScaleTicks(COINSPEED), x); // Find the lowest active pixel
+
+				if(y) // If a pixel was found in this column...
+				{
+					// Check the coin pixel, or its vertically opposite pixel, against the rounded paddle
+					if(OnPaddle(coin, GetPaddlePosition(), game->coins[n].x + x, game->coins[n].y + y) ||
+						OnPaddle(coin, GetPaddlePosition(), game->coins[n].x + x, game->coins[n].y + (15-y)))
+					{
+						collectedCoin = true; // The coin will be collected
+					}
+				}
+			}
+		}
+		
+		if(collectedCoin) // If the coin is marked for collection...
+		{
+			PostEvent(EVENT_COINCOLLECTED, 0, game->coins[n].x, game->coins[n].y, game->coins[n].powerup); // Play the coin collection sound
+			GainPowerup(game->coins[n].powerup); // Give the player the coins powerup
+			LoseCoin(n); // Remove the coin, the last coin takes its place
+		}
+		else // If the coin was not marked for collection...
+		{			
+			if(game->coins[n].y + COINDROP > (GAMEHEIGHT * TILESIZE)) // If the coin is falling off the bottom of the board...
+			{
+				LoseCoin(n); // Remove the coin from the game, the last coin takes its place
+			}
+			else // If the coin is not falling off the bottom of the board...
+			{
+				game->coins[n].y = game->coins[n].y + TickShare(COINDROP); // Drop the coin by two pixels
+				n++; // Move onto the next coin
+			}
+		}
+	}
+}
+
+void LoseCoin(int num) // Remove the given coin from the game
+{
+	game->coins.Remove(num); // The last coin takes its place
+}
+
+void AddCoin(int powerup, int x, int y) // Add a new coin if there is room
+{
+	int n; // The new coin
+
+	n = game->coins.Add();
+	if(n != -1) // If there was room...
+	{
+		// Create the new coin
+		game->coins[n].powerup = powerup;
+		game->coins[n].rotationPos = 0;
+		game->coins[n].x = x;
+		game->coins[n].y = y;
+		game->coins[n].lastX = x; // The coin appears where the brick was
+		game->coins[n].lastY = y;
+		PostEvent(EVENT_POWERUPSPAWNED, 0, x, y, powerup);
+	}
+}
+
+void LoadCoinMap() // Load the coin pixel maps from file
+{
+	int x, y; // Counters
+	char ch; // Place holder for each character as it's read from the file.
+	int coinPos; // Rotation position
+	FILE *coinMapFile;  // File to read the coin map data from
+	
+	// Variables for handling the characters retrieved from the file
+	std::ostringstream fileNum;
+	std::string strNum;
+
+	coinMapFile = fopen("CoinMap.txt", "r"); // Open CoinMap.txt for reading
+
+	if(coinMapFile != NULL) // Check that the file opened
+	{
+		do {
+			ch = fgetc(coinMapFile); // Grab the first character in the file
+			if(ch == 'P') // Found a position marker
+			{
+				fileNum.str(""); // Reset the data stream
+				ch = fgetc(coinMapFile); // Retrieve the first digit
+				
+				while(ch != '\n' && ch != EOF) // Retrieve all the characters left on the line
+				{
+					fileNum << ch; // Concatenate each character retrieved into one variable
+					ch = fgetc(coinMapFile); // Retrieve the next character
+				}
+				strNum = fileNum.str(); // Convert the coin poistion digits to a string
+				coinPos = atoi(strNum.c_str()) - 1; // Convert the string to an integar
+
+				// Retrieve the pixel information for the coin map
+				for(y = 0; y < 16; y++)
+				{
+					for(x = 0; x < 16; x++)
+					{
+						fileNum.str(""); // Reset the data stream
+						ch = fgetc(coinMapFile); // Retrieve the first digit
+						while(ch != ',' && ch != '\n' && ch != EOF)
+						{
+							fileNum << ch; // Concatenate each character retrieved into one variable
+							ch = fgetc(coinMapFile); // Retrieve the next character
+						}
+
+						strNum = fileNum.str(); // Convert the coin pixel digits to a string
+						coinMap[coinPos][x][y] = atoi(strNum.c_str()); // Store the pixel state as an integar
+					}
+				}
+			}
+		} while (ch != EOF);
+
+		fclose (coinMapFile); // Stop reading the file
+	}
+	BuildCoinBottoms(); // Find the lowest pixel of each coin column
+}
+
+void GainPowerup(int num) // Apply a powerup
+{
+	int n; // Counter
+
+	PostEvent(EVENT_POWERUPGAINED, 0, 0, 0, num); // Play the powerup's sound
+	switch(num) // Apply the appropriate powerup
+	{
+	case INCPADDLESIZE:
+		AdjustPaddleSize(1); // Increase paddle size
+		AddMessage(INCPADDLESIZE); // Add the appropriate message
+		return;
+	case DECPADDLESIZE:
+		AdjustPaddleSize(-1); // Decrease paddle size
+		AddMessage(DECPADDLESIZE); // Add the appropriate message
+		return;
+	case INCPADDLESPEED:
+		AdjustPaddleSpeed(1); // Increase paddle speed
+		AddMessage(INCPADDLESPEED); // Add the appropriate message
+		return;
+	case DECPADDLESPEED:
+		AdjustPaddleSpeed(-1); // Decrease paddle speed
+		AddMessage(DECPADDLESPEED); // Add the appropriate message
+		return;
+	case INCBALLSIZE:
+		n = 0;
+		while(n < game->balls.Count()) // Cycle through all the balls
+		{
+			AdjustBallSize(n, 1); // Increase the ball size
+			n++;
+		}
+		AddMessage(INCBALLSIZE); // Add the appropriate message
+		return;
+	case DECBALLSIZE:
+		n = 0;
+		while(n < game->balls.Count()) // Cycle through all the balls
+		{
+			AdjustBallSize(n, -1); // Decrease the ball size
+			n++;
+		}
+		AddMessage(DECBALLSIZE); // Add the appropriate message
+		return;
+	case INCBALLSPEED: // Not used anymore
+		AddMessage(INCBALLSPEED); // Add the appropriate message
+		return;
+	case DECBALLSPEED: // Not used anymore
+		AddMessage(DECBALLSPEED); // Add the appropriate message
+		return;
+	case EXTRABALL:
+		n = game->multiball ? game->balls.Count() : 1; // The multiball mode doubles the balls in play
+		while(n > 0)
+		{
+			AddBall(); // Add another ball
+			n--;
+		}
+		AddMessage(EXTRABALL); // Add the appropriate message
+		return;
+	case EXTRALIFE:
+		AddLife(); // Add an extra life
+		AddMessage(EXTRALIFE); // Add the appropriate message
+		return;
+	case MAGNETIC:
+		game->magnetic = ExtendTimer(TIMER_MAGNETIC, NOTIMEROWNER, game->magnetic, ScaleTicks(POWERUPTIME)); // Add extra time to the magnetic powerup
+		AddMessage(MAGNETIC); // Add the appropriate message
+		return;
+	case FIREBALL:
+		AddFire(); // Add extra time to the fire powerup
+		AddMessage(FIREBALL); // Add the appropriate message
+		return;
+	case GUNS:
+		if(game->laser > 0 && game->laserPierce < MAXLASERPIERCE) // If the lasers are already armed...
+		{
+			game->laserPierce++; // Their bullets pass through another brick
+		}
+		game->laser = ExtendTimer(TIMER_LASER, NOTIMEROWNER, game->laser, ScaleTicks(POWERUPTIME)); // Add extra time to the laser powerup
+		AddMessage(GUNS); // Add the appropriate message
+		return;
+	case EXPLOSIVE:
+		AddExplosive(); // Add extra time to the explosive powerup
+		AddMessage(EXPLOSIVE); // Add the appropriate message
+		return;
+	}
+}
+
+void AddFire() // Add extra time to the fire powerup
+{
+	int n; // Counter
+
+	n = 0;
+	while(n < game->balls.Count()) // Cycle through the balls
+	{
+		game->balls[n].fire = ExtendTimer(TIMER_FIRE, game->balls.Handle(n), game->balls[n].fire, ScaleTicks(POWERUPTIME)); // Add extra time to the fire powerup
+		game->balls[n].explosive = 0; // Remove any explosive powerup
+		n++;
+	}
+
+}
+
+void AddExplosive() // Add extra time to the explosive powerup
+{
+	int n; // Counter
+
+	n = 0;
+	while(n < game->balls.Count()) // Cycle through the balls
+	{
+		game->balls[n].fire = 0; // Remove any fire powerup
+		game->balls[n].explosive = ExtendTimer(TIMER_EXPLOSIVE, game->balls.Handle(n), game->balls[n].explosive, ScaleTicks(POWERUPTIME)); // Add extra time to the esplosive powerup
+		n++;
+	}
+}
+
+unsigned int ExplosionPattern(int size) // Returns the 5x5 square of bricks an explosive ball of the given size knocks out
+{
+	int n, m; // counters
+	bool knockOut = false; // To mark a block for deletion
+	unsigned int pattern = 0; // Bit (n+2)*5+(m+2) is set if the brick n across and m down is knocked out
+
+	// Cycle through a 5x5 grid around the given brick
+	for(n = -2; n <= 2; n++)
+	{
+		for(m = -2; m <= 2; m++)
+		{
+			knockOut = false; // Default to non-deletion
+			if(size < 3) // If the ball that knocked out the brick is small...
+			{
+				if( (n == 0 || m == 0) && (n != 2 && n != -2 && m != 2 && m != -2)  )
+				{ // Knock out the adjacent bricks
+					knockOut = true;
+				}
+			}
+			if(size > 2 && size < 6) // If the ball is a medium size...
+			{
+				if( (n >= -1 && n <= 1) && (m >= -1 && m <= 1) )
+				{ // Knock out the 3x3 grid of bricks around the given brick
+					knockOut = true;
+				}
+			}
+			if(size > 5) // If the ball was large...
+			{
+				if( (n >= -1 && n <= 1) || (m >= -1 && m <= 1) )
+				{ // Knock out the 3x3 grid and the bricks adjoining it
+					knockOut = true;
+				}
+			}
+
+			if(knockOut) // If the brick is marked to be knocked out...
+			{
+				pattern |= 1u << ((n + 2) * 5 + (m + 2));
+			}
+		}
+	}
+	return pattern;
+}
+
+void BuildExplosionStencils() // Split the explosion pattern of each ball size into rows of bricks
+{
+	int size, n, m; // Counters
+	unsigned int pattern; // The 5x5 square for the size
+
+	for(size = 0; size < 8; size++)
+	{
+		pattern = ExplosionPattern(size);
+		for(m = 0; m < 5; m++)
+		{
+			explosionStencils[size][m] = 0;
+			for(n = 0; n < 5; n++)
+			{
+				if((pattern >> (n * 5 + m)) & 1) // Bit n+2 of row m+2 is the brick n across and m down
+				{
+					explosionStencils[size][m] |= 1 << n;
+				}
+			}
+		}
+	}
+}
+
+unsigned long long ExplosionStencilRow(int size, int m, int x) // Returns the bricks in the row m down from x,y that an explosion of the given size at x,y covers
+{
+	unsigned long long row = explosionStencils[size][m + 2]; // Bricks x-2 to x+2 as bits 0 to 4
+
+	return x >= 2 ? row << (x - 2) : row >> (2 - x); // Line them up with the board, dropping any off the left side
+}
+
+void ExplodeBrick(int num, int x, int y, bool explosiveBrick) // Explode the bricks around the recently removed x,y brick and any explosive bricks caught in it
+{
+	// Structure for an explosion waiting to go off
+	struct Blast{
+		int x, y; // Brick in the centre
+		int size; // Ball size whose pattern it uses
+	};
+	// Each brick is knocked out once, so it can set off at most one explosion (plus the two at x,y)
+	Blast blasts[BGAMEWIDTH*BGAMEHEIGHT + 2];
+	int numBlasts = 0, next = 0; // Explosions queued and gone off
+	// Coins are added once every explosion has gone off, in the order their bricks were knocked out
+	int coinPowerups[BGAMEWIDTH*BGAMEHEIGHT], coinX[BGAMEWIDTH*BGAMEHEIGHT], coinY[BGAMEWIDTH*BGAMEHEIGHT];
+	int numCoins = 0;
+	unsigned long long hits[5]; // The bricks knocked out in each row of the current explosion
+	bool greyKnockOut = game->balls[num].size >= KNOCKOUTBALLSIZE; // Grey bricks are only knocked out by larger balls
+	int knockedOut = 0; // Number of bricks that count towards finishing the level
+	int n, m; // Offsets of the brick being knocked out
+	int bx, by; // The brick being knocked out
+	int powerup; // The powerup coin of a knocked out brick
+
+	if(game->balls[num].explosive) // An explosive ball's explosion depends on its size
+	{
+		blasts[numBlasts].x = x;
+		blasts[numBlasts].y = y;
+		blasts[numBlasts].size = game->balls[num].size;
+		numBlasts++;
+	}
+	if(explosiveBrick) // An explosive brick always blows out the 3x3 square
+	{
+		blasts[numBlasts].x = x;
+		blasts[numBlasts].y = y;
+		blasts[numBlasts].size = EXPLOSIVEBRICKSIZE;
+		numBlasts++;
+	}
+
+	while(next < numBlasts) // Set the explosions off in turn, so a long chain can't run out of stack
+	{
+		Blast &blast = blasts[next];
+
+		// Lay the stencil over the five rows it covers
+		for(m = -2; m <= 2; m++)
+		{
+			hits[m+2] = ExplosionStencilRow(blast.size, m, blast.x) & BrickRow(blast.y+m);
+			if(!greyKnockOut)
+			{
+				hits[m+2] &= ~GreyRow(blast.y+m); // If the ball is too small then nothing happens to grey bricks
+			}
+		}
+
+		// Score the bricks in the same order as a sweep of the 5x5 square, so the multiplier adds up the same
+		for(n = -2; n <= 2; n++)
+		{
+			bx = blast.x + n;
+			if(bx < 0 || bx >= BGAMEWIDTH)
+			{
+				continue;
+			}
+			for(m = -2; m <= 2; m++)
+			{
+				by = blast.y + m;
+				if(!((hits[m+2] >> bx) & 1)) // If the brick isn't caught in the explosion...
+				{
+					continue;
+				}
+				if(BrickColour(bx, by) != 1) // If it is not a grey brick...
+				{
+					if(!BrickStyle(bx, by) || !BrickColour(bx, by)) // If it isn't a whole block...
+					{
+						hits[m+2] &= ~(1ULL << bx); // Leave it where it is
+						continue;
+					}
+					// Add points based on the type of brick that was knocked out and active multipliers
+					PostEvent(EVENT_BRICKDESTROYED, CAUSE_EXPLOSION, bx*BRICKSIZE, by*BRICKSIZE,
+						BrickPoints(BrickStyle(bx, by), BrickColour(bx, by), game->balls[num].bricks));
+					game->balls[num].bricks++; // Increase the brick score multiplier for the ball
+					game->balls[num].greyBricks = 0; // Reset the grey brick counter
+					knockedOut++;
+				}
+
+				// If there was a powerup coin attached to the brick...
+				powerup = TakeBrickPowerup(bx, by); // Take any powerup coin off the brick
+				if(powerup)
+				{
+					coinPowerups[numCoins] = powerup;
+					coinX[numCoins] = bx*BRICKSIZE;
+					coinY[numCoins] = by*BRICKSIZE;
+					numCoins++;
+				}
+
+				if(BrickExplosive(bx, by)) // If the brick explodes too...
+				{
+					blasts[numBlasts].x = bx;
+					blasts[numBlasts].y = by;
+					blasts[numBlasts].size = EXPLOSIVEBRICKSIZE;
+					numBlasts++;
+				}
+			}
+		}
+
+		// Remove the bricks from the game a row at a time
+		for(m = -2; m <= 2; m++)
+		{
+			RemoveBricks(blast.y+m, hits[m+2]);
+		}
+		next++;
+	}
+
+	if(knockedOut && ChangeNumBricks(-knockedOut)) // Reduce the number of bricks required to clear the level
+	{
+		return; // The level is complete, no coins or explosions to show
+	}
+
+	for(n = 0; n < numCoins; n++)
+	{
+		// Add the coin to the game
+		AddCoin(coinPowerups[n], coinX[n], coinY[n]);
+	}
+	for(n = 0; n < numBlasts; n++)
+	{
+		AddExplosion((blasts[n].x-2)*BRICKSIZE, (blasts[n].y-2)*BRICKSIZE, (blasts[n].size/3) + 1);
+	}
+	if(numBlasts > 1) // If bricks went off as well...
+	{
+		PostEvent(EVENT_CHAINREACTION, 0, x*BRICKSIZE, y*BRICKSIZE, numBlasts); // Play the sound of the chain going off
+	}
+}
+
+void ResetExplosions() // Remove all explosions
+{
+	game->explosions.Clear();
+}
+
+void AddExplosion(int x, int y, int size) // Add an explosion to the game
+{
+	int n; // The new explosion
+
+	n = game->explosions.Add();
+	if(n != -1) // If there was room...
+	{
+		// Create an explosion using the given details
+		game->explosions[n].x = x;
+		game->explosions[n].y = y;
+		game->explosions[n].size = StartTimer(TIMER_EXPLOSION, game->explosions.Handle(n), size*ScaleTicks(FRAMES));
+	}
+}
+
+void RemoveExplosion(int num) // Remove and explosion
+{
+	game->explosions.Remove(num); // The last explosion takes its place
+}
+
+void ResetBullets()// Reset the bullets
+{
+	game->bullets.Clear();
+}
+
+void AddBullets() // Add bullets to the game
+{
+	int n, m; // Counter
+
+	m = 0;
+	while(m < 2) // Add 2 bullets
+	{
+		n = game->bullets.Add();
+		if(n != -1) // If there is room for a bullet...
+		{
+			if(m == 0) // Add the first bullet to the left laser
+			{
+				game->bullets[n].x = GetPaddlePosition() + 6;
+				game->bullets[n].y = TILESIZE*GAMEHEIGHT-16;
+				game->bullets[n].remove = false;
+			}
+			else // Add the second bullet to the right laser
+			{
+				game->bullets[n].x = GetPaddlePosition() + 8*(GetPaddleSize()+1);
+				game->bullets[n].y = TILESIZE*GAMEHEIGHT-16;
+				game->bullets[n].remove = false;
+			}
+			game->bullets[n].pierce = game->laserPierce;
+			game->bullets[n].lastX = game->bullets[n].x; // The bullet leaves from the laser
+			game->bullets[n].lastY = game->bullets[n].y;
+		}
+		m++;
+	}
+
+	PostEvent(EVENT_LASERFIRED, 0, GetPaddlePosition(), TILESIZE*GAMEHEIGHT-16, 0); // Add the laser fire sound
+}
+
+void RemoveBullet(int num) // Remove a bullet
+{
+	game->bullets.Remove(num); // The last bullet takes its place
+}
+
+void MoveBullets() // Move the bullets and check for collisions
+{
+	int n; // Counter
+	int brickX, brickY; // The brick a bullet hits
+	int topRow; // The row the top of a bullet moves into
+	int powerup; // The powerup coin of a knocked out brick
+	int move = TickShare(LASERSPEED); // Number of pixels the bullets travel this game update
+
+	n = 0;
+	while(n < game->bullets.Count()) // Cycle through the bullets
+	{
+		if(game->bullets[n].remove) // If the bullet is marked for removal...
+		{
+			RemoveBullet(n); // The last bullet takes its place
+		}
+		else // If the bullet isn't marked for removal...
+		{
+			// Check for collsion with the top border
+			if(game->bullets[n].y - move <= 0) // If the bullet hits the top border...
+			{
+				game->bullets[n].remove = true; // Mark the bullet for removal
+			}
+			else // If the bullet doesn't hit the top border..
+			{
+				// Cast up the bullet's column from the row above its top to the row it moves into, using the
+				// column bits to jump straight to the next brick, so no brick is missed however far it moves
+				brickX = game->bullets[n].x/BRICKSIZE;
+				topRow = (game->bullets[n].y-move)/BRICKSIZE;
+				brickY = FirstBrickAbove(brickX, (game->bullets[n].y-1)/BRICKSIZE);
+
+				while(brickY >= topRow && !game->bullets[n].remove) // While the bullet hits a brick...
+				{
+					 // If it isn't a grey brick
+					if(BrickColour(brickX, brickY) != 1)
+					{
+						// Add points based on the type of brick that was knocked out and active multipliers, and play the sound
+						PostEvent(EVENT_BRICKDESTROYED, CAUSE_LASER, brickX*BRICKSIZE, brickY*BRICKSIZE,
+							BrickPoints(BrickStyle(brickX, brickY), BrickColour(brickX, brickY), 1));
+						
+						if(ChangeNumBricks(-1)) // Reduce the number of bricks required to clear the level
+						{
+							return; // The level is complete, the bullets will be reset
+						}
+					}
+					else
+					{
+						PostEvent(EVENT_BRICKDESTROYED, CAUSE_LASER, brickX*BRICKSIZE, brickY*BRICKSIZE, 0); // Play the sound for knocking out a brick
+					}
+					
+					// Remove the brick from the level map
+					RemoveBrick(brickX, brickY);
+
+					// If there was a powerup coin attached to the brick...
+					powerup = TakeBrickPowerup(brickX, brickY); // Take any powerup coin off the brick
+					if(powerup)
+					{
+						// Create the powerup coin to the game in place of the brick
+						AddCoin(powerup, brickX*BRICKSIZE, brickY*BRICKSIZE);
+					}
+
+					if(game->bullets[n].pierce > 0) // If the bullet can pass through the brick...
+					{
+						game->bullets[n].pierce--;
+						brickY = FirstBrickAbove(brickX, brickY-1); // Carry on up the column
+					}
+					else
+					{
+						game->bullets[n].remove = true; // Mark the bullet for removal
+					}
+				}
+
+				game->bullets[n].y -= move; // Move the bullet					
+			}
+			n++;
+		}
+	}
+}
+
+void AddMessage(int num) // Add a message to the queue
+{
+	int n; // Counter
+
+	n = 0;
+	while(n < 3) // Cycle through the messages
+	{
+		if(game->messages[n] == 0) // If there is room in the queue for a message...
+		{
+			game->messages[n] = num; // Add the new message to the queue
+			break;
+		}
+		n++;
+	}
+
+	if(n == 0) // If this was the first message in the queue...
+	{
+		game->messageTimer = StartTimer(TIMER_MESSAGE, NOTIMEROWNER, ScaleTicks(MESSAGETIME)); // Show the message for 5s
+	}
+
+	if(n == 3) // If there was no room for a message...
+	{
+		RemoveMessage(); // Make room for a new message
+		game->messages[2] = num; // Add the new message
+	}
+}
+
+void RemoveMessage() // Remove the first message
+{
+	int n; // Counter
+
+	n = 0;
+
+	if(game->messages[n] == 0) // If no message exists...
+	{
+		game->messageTimer = 0; // Set the message timer to inactive
+		return;
+	}
+
+	while(n < 2) // Cycle through the messages
+	{
+		if(game->messages[n+1] > 0) // If another message exists after the current message...
+		{
+			game->messages[n] = game->messages[n+1]; // Overwrite the current message with the next message
+		}
+		else // If no more messages exist
+		{
+			break;
+		}
+		n++;
+	}
+
+	game->messages[n] = 0; // Wipe the redundant message
+	game->messageTimer = StartTimer(TIMER_MESSAGE, NOTIMEROWNER, ScaleTicks(MESSAGETIME)); // Show the next message for 1s
+}
+
+void ClearMessages() // Clear the message queue
+{
+	int n; // Counter
+
+	n = 0;
+	while(n < 3)
+	{
+		game->messages[n] = 0; // Clear the message
+		n++;
+	}
+
+	game->messageTimer = 0;
+}
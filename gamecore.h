@@ -0,0 +1,329 @@
+// GameCore.h
+// The game simulation for the brick knockout game
+// Everything that happens in a game update lives here, with no window, graphics, sound or timer,
+//   so it can be run by the windows game and by the headless runner alike
+
+#ifndef GAMECORE_H
+#define GAMECORE_H
+#pragma once
+
+// Include string functions
+#include <string>
+
+// Include standard library
+#include <vector>
+
+// Include the store the game objects are kept in
+#include "pool.h"
+
+// Declare and define constants
+const int TILESIZE = 8; // Build the game on 8x8 tiles
+const int GAMEHEIGHT = 60; // Game height in tiles
+const int GAMEWIDTH = 80; // Game width in tiles
+const int BRICKSIZE = 16; // Build the bricks on 16x16 tiles
+const int BGAMEHEIGHT = 30; // Game height in bricks
+const int BGAMEWIDTH = 40; // Game width in bricks
+const int BRICKCOLOURS = 9; // The number of brick colours
+const int KNOCKOUTBALLSIZE = 7; // Size a ball needs to be to knockout grey bricks
+const int GREYLOOPREBOUNDS = 20; // Grey bricks a smaller ball rebounds off in a row before it knocks one out anyway (so it can't be trapped)
+
+// Initial values
+const int INITPADDLESIZE = 8; // Default paddle size
+const int INITPADDLESPEED = 5; // Default paddle speed
+
+// Powerup Constants
+const int INCPADDLESIZE = 1; // Increase paddle size
+const int DECPADDLESIZE = 2; // Decrease paddle size
+const int INCPADDLESPEED = 3; // Increase paddle speed
+const int DECPADDLESPEED = 4; // Decrease paddle speed
+const int INCBALLSIZE = 5; // Increase ball sizes
+const int DECBALLSIZE = 6; // Decrease ball sizes
+const int INCBALLSPEED = 7; // Increase ball speeds  // Not used anymore
+const int DECBALLSPEED = 8; // Decrease ball speeds  // Not used anymore
+const int EXTRABALL = 9; // Gain an extra ball
+const int MAGNETIC = 10; // Gain the magnetic paddle for a duration
+const int EXTRALIFE = 11; // Gain an extra life
+const int FIREBALL = 12; // Gain the fire ball for a duration
+const int GUNS = 13; // Gain guns for a duration
+const int EXPLOSIVE = 14; // Gain the explosive ball for a duration
+const int NUM_COMMONPOWERUPS = 10; // Number of common powerups
+const int NUM_RAREPOWERUPS = 4; // Number of rare powerups
+const int POWERUPCHANCE = 3; // Inverse chance of a brick containing a powerup
+const int COINSPEED = 5; // Inverse speed at which the coin turns
+const int COINDROP = 2; // Number of pixels the coin falls per game update
+const int POWERUPTIME = 600; // The time added to powerups that have time limits (divide by 20 for seconds)
+const int MESSAGETIME = 100; // Time in frames for a message to be displayed (20 frames for second)
+const int NOREBOUNDTIME = 4; // Frames a released ball can't be hit by the paddle
+
+// Explosion constants
+const int FRAMES = 15; // Number of frames before the explosion reduces in size
+const int EXPLOSIVEBRICKSIZE = 4; // Ball size whose explosion an explosive brick sets off (the 3x3 square)
+
+// Game object limits (SetPoolSizes can change them)
+const int MAXBALLS = 5; // Most balls in play at once
+const int MAXCOINS = 20; // Most powerup coins falling at once
+const int MAXEXPLOSIONS = 25; // Most explosions showing at once
+const int MAXBULLETS = 20; // Most laser bullets in flight at once
+const int MULTIBALLMAXBALLS = 10000; // Most balls in play at once in the multiball mode
+const int MULTIBALLMAXBULLETS = 5000; // Most laser bullets in flight at once in the multiball mode
+
+// Laser constants
+const int LASERSPEED = 6; // Number of frames the laser travels per game update
+const int MAXLASERPIERCE = 3; // Most bricks a laser bullet can pass through before it stops
+
+// Ball movement constants
+// Ball speeds and the part of a pixel a ball is through are fixed point, with SUBPIXELS parts to a pixel (24.8)
+const int SUBPIXELS = 256; // Parts of a pixel in a fixed point position or speed
+const int LEGACYBALLSTEPS = 5; // Pixels an original ball moves per 20 a second update, split between the two axes
+const int SMOOTHBALLSPEED = 4*SUBPIXELS; // Speed of a smooth ball per 20 a second update
+const int SMOOTHMAXANGLE = 14; // Sideways part of a smooth ball's speed off the end of the paddle, in sixteenths
+const int SMOOTHMINANGLE = 1; // Least sideways part of a smooth ball's speed off the paddle, in sixteenths (never straight up)
+const int BALLMODEL_LEGACY = 0; // The original nine directions with whole pixel speeds
+const int BALLMODEL_SMOOTH = 1; // Any direction, set by exactly where the ball hits the paddle
+const int NUM_BALLMODELS = 2; // Number of ball models
+
+// Timing constants
+// The frame counts and speeds above are all for 20 game updates a second
+// At faster rates ScaleTicks stretches the frame counts and TickShare spreads the movement over the extra updates
+const int BASETICKRATE = 20; // Game updates per second the timing constants are given for
+const int MAXTICKRATE = 240; // Fastest game update rate allowed
+
+// Structure for a ball
+struct Ball{
+	int size; // Between 1 and 7; -1 = no ball
+	int x; // Horizontal position of the ball
+	int y; // Vertical position of the ball
+	int speedX; // Horizontal speed of the ball in 1/256ths of a pixel per 20 a second update
+	int speedY; // Vertical speed of the ball in 1/256ths of a pixel per 20 a second update
+	int subX; // How far through its pixel the ball is horizontally, in 1/256ths of a pixel
+	int subY; // How far through its pixel the ball is vertically, in 1/256ths of a pixel
+	int speedMod; // Not used
+	bool stuck; // Is the ball stuck
+	int fire; // Game tick the fire powerup wears off on (0 = none)
+	int explosive; // Game tick the explosive powerup wears off on (0 = none)
+	int noRebound; // Game tick the ball can be hit with the paddle again on, a short time after leaving it (0 = it can)
+	int bricks; // Number of bricks hit before hitting the paddle again
+	int greyBricks; // Number of grey bricks hit in a row
+	int lastX; // Horizontal position at the start of the game update (for drawing between updates)
+	int lastY; // Vertical position at the start of the game update (for drawing between updates)
+};
+
+// Structure for a coin
+struct Coin{
+	int x; // Horizontal position of the coin
+	int y; // Vertical position of the coin
+	int rotationPos; // Rotation state
+	int powerup; // Powerup the coin has
+	int lastX; // Horizontal position at the start of the game update (for drawing between updates)
+	int lastY; // Vertical position at the start of the game update (for drawing between updates)
+};
+
+// Structure for an explosion
+struct Explosion{
+	int x; // Horizontal positional of the brick that triggered the explosion
+	int y; // Vertical positional of the brick that triggered the explosion
+	int size; // Game tick the explosion ends on, its size is worked out from the time left
+};
+
+// Structure for a laser bullet
+struct Bullet{
+	int x; // Horizontal position of the laser
+	int y; // Vertical position of the laser
+	bool remove; // Mark the bullet for removal
+	int pierce; // Number of bricks the bullet can still pass through after knocking them out
+	int lastX; // Horizontal position at the start of the game update (for drawing between updates)
+	int lastY; // Vertical position at the start of the game update (for drawing between updates)
+};
+
+struct PaddleProfile; // The pixels of the paddle something can touch (profiles.h)
+struct TimerEvent; // A timed effect wearing off (timers.h)
+struct GameEvent; // Something that happened during a game update (events.h)
+
+// Structure for the pixels of the paddle a ball can hit
+struct PaddleBounds{
+	int left; // First pixel of the paddle on the x axis
+	const PaddleProfile *across; // The paddle as seen by a ball moving across it
+	const PaddleProfile *down; // The paddle as seen by a ball moving down onto it
+};
+
+// Structure for the player's input during one game update
+struct TickInput{
+	int paddleDirection; // -1 = move left, 0 = stay still, 1 = move right
+	bool fire; // Release any stuck balls, or fire the lasers if none are stuck
+};
+
+// Structure for the calls the game makes out to whoever is running it
+// Any of these can be left NULL, which is what the headless runner does
+struct GameHooks{
+	void (*sound)(const std::string &sound); // Play the given sound effect
+	void (*levelLoaded)(int level); // A new level was loaded (load its background, restart the timer, redraw)
+	void (*events)(const GameEvent *events, int count); // The events of a game update, once it has finished (for a HUD or telemetry)
+};
+
+// Structure for a level of the levels file, as LoadLevelPack read it
+struct PackLevel{
+	int id; // The level number after its L marker
+	int style[BGAMEWIDTH][BGAMEHEIGHT]; // Style of the brick in each cell (0 = no brick)
+	int colour[BGAMEWIDTH][BGAMEHEIGHT]; // Colour of the brick in each cell
+	bool explosive[BGAMEWIDTH][BGAMEHEIGHT]; // Does the brick in each cell explode when knocked out
+};
+
+// Shared game data, loaded once by InitGame and only read while the games run
+// The rest of a game's variables are kept in its GameState (gamestate.h)
+extern int maxLevel; // The humber of levels (maps)
+extern unsigned int levelPackHash; // Hash of the levels file, so a replay can tell if the levels have changed
+extern std::vector<PackLevel> levelPack; // The levels of the levels file, in the order they are in the file
+extern int brickStyles; // The number of brick styles
+extern int coinMap[8][16][16]; // The different pixel layouts for powerup coins
+
+// Sound file constants
+extern const std::string SOUND_BRICKKO; // Sound file when the ball knocks out a brick
+extern const std::string SOUND_BRICKREBOUND; // Sound file when the ball rebounds off an indestructable brick
+extern const std::string SOUND_BORDERREBOUND; // Sound file when the ball rebounds off a border
+extern const std::string SOUND_PADDLEREBOUND; // Sound file when the ball rebounds off the paddle
+extern const std::string SOUND_LOSELIFE; // Sound file when a life is lost
+extern const std::string SOUND_GAMEOVER; // Sound file when the game is lost
+extern const std::string SOUND_COIN; // Base sound file name when a coin is collected
+extern const std::string SOUND_PADDLESIZEINC; // Sound file when paddle size increase is gained
+extern const std::string SOUND_PADDLESIZEDEC; // Sound file when paddle size decrease is gained
+extern const std::string SOUND_PADDLESPEEDINC; // Sound file when paddle speed increase is gained
+extern const std::string SOUND_PADDLESPEEDDEC; // Sound file when paddle speed decrease is gained
+extern const std::string SOUND_BALLSIZEINC; // Sound file when ball size increase is gained
+extern const std::string SOUND_BALLSIZEDEC; // Sound file when ball size decrease is gained
+extern const std::string SOUND_EXTRABALL; // Sound file when an extra ball is gained
+extern const std::string SOUND_MAGNETISM; // Sound file when magnetism is gained
+extern const std::string SOUND_EXTRALIFE; // Sound file when an extra life is gained
+extern const std::string SOUND_FIREBALL; // Sound file when fireball is gained
+extern const std::string SOUND_GUNS; // Sound file when laser guns are gained
+extern const std::string SOUND_EXPLOSIVE; // Sound file when explosive ball is gained
+extern const std::string SOUND_LASERFIRE; // Sound file when laser gun is fired
+
+// Get Functions
+
+int GetPaddleSize(); // Return the paddle size
+int GetPaddlePosition(); // Return the paddle position on the board
+int GetPaddleSpeed(); // Return the speed of the paddle
+int GetPaddleDirection(); // Get the direction the paddle is moving
+int GetLevel(); // Get the level number
+int GetMaxLevel(); // Returns the max level in the game
+int GetLife(); // Returns the number of lives
+int GetNumBricks(); // Returns the number of bricks
+int GetPausedGame(); // Return the value of gamePaused
+int GetScore(); // Returns the score
+int GetScoreMultiplier(); // Returns the score mulitplier
+int GetTickRate(); // Returns the number of game updates a second
+
+// Set functions
+
+void AdjustPaddleSize(int size); // Set the paddle size 4 to 12
+void AdjustPaddleSpeed(int speedChange); // Change the speed of the paddle
+void SetPaddleDirection(int num); // Set the direction the paddle is moving
+void MovePaddlePosition(); // Move the paddle position moveX pixels
+int StepsToReach(int pos, int dir, int low, int high); // Number of pixel steps from pos before a step lands in low to high (-1 = never)
+int PaddleClearSteps(const PaddleProfile &push, int maxSteps); // Number of pixels the paddle can move before it touches a border or a ball
+bool PaddleStep(const PaddleProfile &push); // Move the paddle one pixel and deal with anything it touches, returns false if it has to stop
+void ReleaseBall(int num); // Release the ball from the paddle
+void ReleaseOrFire(); // Release any stuck balls, or fire the lasers if none are stuck
+void MoveBalls(); // Move the corresponding ball
+void SweepBall(int num); // Move a ball one game update, checking only the steps where it could touch something
+int FirstCrossing(int sub, int dir); // 1/256ths of a pixel a ball moves in direction dir before its first pixel step
+int StepsWithin(long long distance, int first); // Number of pixel steps made moving distance 1/256ths of a pixel
+bool StepXFirst(int countX, int countY, int firstX, int firstY, int distX, int distY); // Does the countX'th horizontal step come before the countY'th vertical step
+void ReflectBall(int num, int normalX, int normalY); // Bounce a ball off a surface facing normalX,normalY
+int BallDirection(int num); // The nearest of the nine original directions (-4 to 4) to the way the ball is moving
+void SetBallModel(int model); // Change how the balls move and rebound off the paddle
+int GetBallModel(); // Returns how the balls move and rebound off the paddle
+void SetMultiball(bool on); // Turn the multiball mode on or off, start a new game after
+bool GetMultiball(); // Is the multiball mode on
+void SetBroadPhase(bool on); // Turn the clear move check before the step by step sweep on or off (for timing it)
+bool BallMoveClear(int num, int moveX, int moveY); // Can the ball move moveX,moveY 1/256ths of a pixel without touching anything
+int IntSqrt(long long n); // Returns the whole square root of n
+bool InPaddleZone(int num); // Is the ball low enough that it could touch the paddle or fall off the board
+int ClearStepsX(int num, int dirX); // Number of horizontal steps the ball can take without touching anything
+int ClearStepsY(int num, int dirY); // Number of vertical steps the ball can take without touching anything
+bool BallOverlapsBricks(int num); // Does any pixel of the ball lie inside a brick
+void ChangeLevel(int num); // Advance or retreat num of levels
+void AdjustBallSize(int num, int sizeChange); // Adjusts ball num's size
+void LoseBall(int num); // Lose the num ball
+void AddBall(); // Gain 1 or 2 extra balls
+void UseLife(); // Place a new ball
+void AddLife(); // Adds one to the lives if it's not at max
+void ResetNumBricks(); // Resets the number of bricks to 0
+bool ChangeNumBricks(int num); // Changes the number of bricks, returns true if the level is complete (the new level loads at the end of the game update)
+int BrickPoints(int x, int y, int brickMultiplier); // Returns the score for a brick based on the block type (x and y), level and multipliers
+void ChangeScoreMultiplier(int num); // Changes the score multiplier
+void ClearCoins(); // Clear the coin array
+void DropCoins(); // Drops the coins 1 step
+void AddCoin(int powerup, int x, int y); // Adds a coin to the board if there is room
+void LoseCoin(int num); // Removes a coin from the array
+void GainPowerup(int num); // Gains a powerup
+void AddFire(); // Adds fire powerup to the balls, removes explosive
+void AddExplosive(); // Adds explosive powerup to the balls, removes fire.
+unsigned int ExplosionPattern(int size); // Returns the 5x5 square of bricks an explosive ball of the given size knocks out
+void BuildExplosionStencils(); // Split the explosion pattern of each ball size into rows of bricks
+unsigned long long ExplosionStencilRow(int size, int m, int x); // Returns the bricks in the row m down from x,y that an explosion of the given size at x,y covers
+void ExplodeBrick(int num, int x, int y, bool explosiveBrick); // Explode the bricks around the recently removed x,y brick and any explosive bricks caught in it
+void ResetExplosions(); // Reset the explosions
+void AddExplosion(int x, int y, int size); // Add an explosion to the game
+void RemoveExplosion(int num); // Remove an explosion
+void ResetBullets(); // Reset the bullets
+void AddBullets(); // Add bullets to the game
+void RemoveBullet(int num); // Remove a bullet
+void MoveBullets(); // Move the bullets and check for collisions
+void AddMessage(int num); // Add a message to the queue
+void RemoveMessage(); // Remove the first message
+void ClearMessages(); // Clear the message queue
+void AddSound(const std::string &sound); // Pass a sound on to the sound hook, if there is one
+void DispatchGameEvents(); // Add up the score, play the sounds and pass on the events of the game update
+const std::string *EventSound(const GameEvent &event); // Returns the sound an event makes (NULL = none)
+const std::string *PowerupSound(int powerup); // Returns the sound a powerup makes when gained (NULL = none)
+
+// Load Functions
+
+bool LoadLevel(int num); // Load level num from the level table
+void LoadLevelPack(); // Read the levels file into the level table, with the number of levels and brick styles, and hash it (only between games)
+const PackLevel *FindPackLevel(int num); // Returns level num of the level table (NULL = it isn't in the levels file)
+int PackCharacter(const std::string &text, size_t &pos); // Returns the next character of the levels file (EOF at the end)
+int PackNumber(const std::string &text, size_t &pos, int &ch, int end1, int end2); // Reads the characters of the levels file up to end1 or end2 as a number, ch is left on the one it stopped at
+void LoadCoinMap(); // Loads the coin map
+
+// Game functions
+
+void InitGame(); // Load the game data shared by every game
+void SetPoolSizes(int maxBalls, int maxCoins, int maxExplosions, int maxBullets); // Set how many of each game object there is room for, start a new game after
+void StartGame(); // Start a new game
+void SeedGame(unsigned long long seed); // Start the random streams of the selected game from a seed
+int GameRandom(int stream, int range); // Returns a random number in 0 to range-1 from one of the selected game's random streams
+void GameOver(); // All lives are lost
+void UnpauseGame(); // Set gamePaused to 0
+void StepGame(const TickInput &input); // Run one game update on the selected game with the given input
+void SaveLastPositions(); // Remember where everything is before a game update moves it
+void ChecksumAdd(unsigned int &sum, unsigned int value); // Add a value to a checksum (FNV-1a, a byte at a time)
+unsigned int GameChecksum(); // Returns a hash of everything in the selected game that changes how it plays out
+
+// Timing functions
+
+bool SetTickRate(int rate); // Change the number of game updates a second (a multiple of 20, up to 240)
+int TickScale(); // Number of game updates in the time of one 20 a second update
+int ScaleTicks(int ticks); // Converts a count of 20 a second frames into game updates at the current rate
+int TickShare(int amount); // The part of a 20 a second update's movement that is made in this game update
+int RescaleTimer(int ticks, int oldScale, int newScale); // Converts a running timer from one tick scale to another
+void RescaleTimers(int oldScale, int newScale); // Converts all the running timers from one tick scale to another
+int RescaleDue(int kind, PoolHandle owner, int due, int oldScale, int newScale); // Returns the tick a running effect wears off on in the new tick scale, and schedules it
+void TimerExpired(const TimerEvent &event); // A timed effect has worn off, called by the timer wheel
+
+unsigned int PixelRangeMask(int first, int last); // Returns a mask with bits first to last set, clipped to 16 bits
+unsigned int BrickRowMask(int px, int py); // Returns a mask with bit x set if pixel px+x,py is inside a brick
+unsigned int BrickColumnMask(int px, int py); // Returns a mask with bit y set if pixel px,py+y is inside a brick
+unsigned int RowContacts(int num, int y, int moveX, int moveY); // Pixels in a ball's row that could hit something if it moves
+unsigned int ColumnContacts(int num, int x, int moveY); // Pixels in a ball's column that could hit something if it moves
+PaddleBounds GetPaddleBounds(); // Returns where the paddle is and the profiles a ball sees it through
+void PaddleRebound(int num); // The ball hit the paddle, so stick it or send it back up
+void HitBrick(int num, int brickX, int brickY, int normalX, int normalY); // The ball hit the brick at brickX,brickY on its side facing normalX,normalY
+bool CollisionCheck(int num, int moveX, int moveY); // Checks if the ball collides
+	/*
+	False = No Collision / Move
+	True = Collision / Don't Move
+	*/
+
+#endif
@@ -0,0 +1,96 @@
+// GameState.h
+// Everything that changes as one game is played, gathered in one place so a process can run many games
+// The game functions work on the game selected by the calling thread (SelectGame), so each thread can
+//   step its own games with nothing shared between them
+// The data loaded once by InitGame (ball shapes, paddle profiles, explosion stencils, coin maps and the
+//   level table, with the number of levels and brick styles) is shared by every game and only read while
+//   the games run
+
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+#pragma once
+
+// Include the game core header for the game objects
+#include "gamecore.h"
+
+// Include the headers for the bricks, timers and events each game keeps
+#include "brickgrid.h"
+#include "timers.h"
+#include "events.h"
+#include "random.h"
+
+// Each thread has its own selected game
+// C++11 thread_local makes every use from another file go through a call checking it has been set up,
+//   which the game functions can't afford, so a plain pointer uses the compiler's own thread storage
+#ifdef _MSC_VER
+#define GAMETHREADLOCAL __declspec(thread)
+#else
+#define GAMETHREADLOCAL __thread
+#endif
+
+// Structure for one game
+struct GameState{
+	// The paddle
+	int paddleSize; // Number of 8pi blocks in the centre of the paddle
+	int paddlePos; // The first pixel position of the paddle on the x axis
+	int lastPaddlePos; // The paddle position at the start of the game update (for drawing between updates)
+	int paddleSpeed; // The speed of the paddle
+	int paddleDirection; // The direction the paddle is moving
+
+	// The game objects
+	Pool<Ball> balls; // The 16x16 balls in play
+	Pool<Coin> coins; // The powerup coins falling
+	Pool<Explosion> explosions; // The explosions showing
+	Pool<Bullet> bullets; // The laser bullets in flight
+	BrickGrid brickGrid; // The bricks of the current level
+
+	// Powerups
+	int magnetic; // Game tick magnetic wears off on (0 = not magnetic)
+	int laser; // Game tick laser wears off on (0 = no lasers)
+	int laserPierce; // Number of bricks new laser bullets pass through (more guns coins while armed)
+
+	// Progress through the game
+	int livesRemaining; // Number of extra lives left
+	int level; // Current level (map) in the game
+	int scoreMultiplier; // A multiplier for the score
+	int numBricks; // The number of bricks left on the current level
+	int gamePaused; // Game is paused if not 0. Also defines the help page currently showing
+	int score; // The players score
+	bool gameLost; // Game is currently lost
+	bool levelComplete; // The last brick of the level was knocked out this game update, the next level loads once it has finished
+	int messages[3]; // Game messages
+	int messageTimer; // Game tick the message on show clears on (0 = no message timing)
+
+	// Timing and settings
+	int gameTick; // Number of game updates run so far, the clock the timers count in
+	TimerWheel timerWheel; // The events waiting to fire
+	int tickRate; // Number of game updates a second
+	int tickPhase; // Which of the updates making up one 20 a second update is being run
+	int ballModel; // How the balls move and rebound off the paddle
+	bool multiball; // Extra ball coins double the balls in play, with room for thousands of them
+	bool broadPhase; // Move balls whose whole move is clear of everything without checking each step
+
+	unsigned long long seed; // The seed the random streams were started from
+	RandomStream randoms[NUM_RANDOMSTREAMS]; // The random streams, one for each kind of use
+
+	std::vector<GameEvent> gameEvents; // The events of the game update in progress
+	GameHooks gameHooks; // Calls out to whoever is running the game
+};
+
+extern GAMETHREADLOCAL GameState *game; // The game the calling thread is working on
+
+// Structure that selects a game for as long as it is in scope, then selects the game that was selected before
+// Anything that works on a second game for a moment (a scratch copy, a game being loaded) selects it with one
+//   of these, so the game being played is selected again however the function returns
+struct GameSelection{
+	GameState *previous; // The game selected before
+
+	GameSelection(GameState &state) : previous(game) { game = &state; }
+	~GameSelection() { game = previous; }
+};
+
+void SelectGame(GameState &state); // Make the game functions on this thread work on the given game
+void SetupGame(GameState &state, unsigned long long seed); // Set up a new game with the first board, paused, from the given seed, and select it
+void StepGame(GameState &state, const TickInput &input); // Run one game update on the given game, leaving the game selected before selected
+
+#endif
@@ -0,0 +1,1358 @@
+// Headless.cpp
+// Runs the brick knockout game simulation with no window, graphics, sound or timer
+// Build from the game directory (so Levels.txt and CoinMap.txt are found) with:
+//   g++ -O2 -std=c++11 gamecore.cpp ballshape.cpp brickgrid.cpp profiles.cpp timers.cpp events.cpp random.cpp replay.cpp savegame.cpp rewind.cpp autopilot.cpp headless.cpp -pthread -o headless
+// Usage: headless [level] [ticks] [seed] [rate] [model]   (rate is game updates a second, 20 to 240,
+//          model is 0 for the original ball directions or 1 for smooth balls)
+//        headless collision [level] [steps] [seed]   (time a collision check per ball step)
+//        headless multiball [balls] [ticks] [seed] [level]   (time game updates with many balls in play,
+//          with and without the broad phase, at 10 to 10000 balls if no number is given)
+//        headless explosions [percent] [chains] [seed]   (time chain reactions on a board packed with bricks,
+//          percent of them explosive)
+//        headless lasers [bullets] [ticks] [seed]   (time laser bullets on a board packed with bricks,
+//          with and without piercing shots)
+//        headless record <file> [ticks] [seed] [rate] [model]   (play a game until it's lost or ticks run out,
+//          and save it as a replay)
+//        headless replay <file> [repeats]   (play a replay back as fast as it will go, checking it plays out
+//          the same, exits with 1 if it doesn't)
+//        headless save <file> [ticks] [seed] [level]   (play a game for ticks and save it part way through)
+//        headless load <file> [ticks] [repeats]   (time saving and loading a saved game, then check it plays on
+//          the same after a save and load, exits with 1 if it doesn't)
+//        headless rewind [ticks] [seed] [rate]   (keep the rewind frames of a game, then load every frame kept
+//          and step back through them, checking each is the game as it was, exits with 1 if one isn't)
+//        headless autopilot [level] [ticks] [seed] [rate] [model]   (play with the autopilot and with the simple
+//          ball follower, reporting how each does, what the landing predictions cost and how many came true)
+//        headless analyse [games] [minutes] [threads] [rate] [model] [seed]   (play games of every level in
+//          Levels.txt with the autopilot on all cores, each from its own seed until the level is cleared, the
+//          game is lost or minutes of play run out, and report how hard each level is, with the games that
+//          ran out of time counted in the clear times as taking longer than the cap, and beside them the time
+//          taken to knock out 90% of the bricks, which the last few hard to reach bricks don't hold up)
+
+// Include the game core header
+#include "gamecore.h"
+#include "ballshape.h"
+#include "brickgrid.h"
+#include "events.h"
+#include "gamestate.h"
+#include "replay.h"
+#include "savegame.h"
+#include "rewind.h"
+#include "autopilot.h"
+
+// Include standard library
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// Include the clock used to report the tick rate
+#include <chrono>
+
+// Include threads for analysing levels on every core
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+// Declare functions
+void SetupRun(int startLevel); // Start a new game and move to the starting level
+TickInput AutoInput(); // Work out the input for the next game update
+void CountEvents(const GameEvent *events, int count); // Tally the events of a game update
+int CollisionBenchmark(int startLevel, long long steps, unsigned int seed); // Time CollisionCheck against the old pixel scan
+bool LegacyCollisionScan(int map[16][16], int num, int moveX, int moveY); // The pixel by pixel scan CollisionCheck used before ball shapes were masks
+int MultiballBenchmark(int numBalls, long long ticks, unsigned int seed, int startLevel); // Time game updates with many balls, with and without the broad phase
+double MultiballRun(int numBalls, long long ticks, unsigned int seed, int startLevel, bool broad); // Run the game holding numBalls in play, returns the seconds taken
+void TopUpBalls(int numBalls); // Add balls at random clear spots until there are numBalls in play
+int ExplosionBenchmark(int percent, long long chains, unsigned int seed); // Time chain reactions of explosive bricks on a packed board
+void PackBoard(int percent); // Fill the board with bricks, percent of them explosive
+int LaserBenchmark(int numBullets, long long ticks, unsigned int seed); // Time laser bullets on a packed board
+double LaserRun(int numBullets, long long ticks, int pierce, long long &bricks); // Run bullets that pass through pierce bricks, returns the seconds taken
+int RecordReplay(const char *filename, long long ticks, unsigned long long seed, int rate, int model); // Play a game with AutoInput and save it as a replay
+int ReplayBenchmark(const char *filename, int repeats); // Play a replay back, checking and timing it
+int SaveRun(const char *filename, long long ticks, unsigned long long seed, int startLevel); // Play a game with AutoInput and save it part way through
+int LoadBenchmark(const char *filename, long long ticks, int repeats); // Time saving and loading a saved game and check it plays on the same
+int RewindBenchmark(long long ticks, unsigned long long seed, int rate); // Time keeping rewind frames and check every frame kept loads as the game was
+int AutopilotBenchmark(int startLevel, long long ticks, unsigned long long seed, int rate, int model); // Play with the autopilot and with AutoInput, and time the landing predictions
+void AutopilotRun(int startLevel, long long ticks, unsigned long long seed, int rate, int model, bool pilotOn); // Play for ticks with the autopilot or AutoInput and report how it went
+
+// Structure for one game played by the level analyser
+struct AnalysedGame{
+	int level; // Level played
+	unsigned long long seed; // Seed it was played from
+	int ticks; // Game updates played
+	bool cleared; // The level was cleared
+	bool lost; // The game was lost (neither = minutes of play ran out)
+	int livesLost; // Number of lives lost, including the last
+	int coinsSpawned; // Number of powerup coins that appeared
+	int coinsCaught; // Number of them caught
+	int greyLoops; // Number of times a ball was let through a grey brick after rebounding off them GREYLOOPREBOUNDS times in a row
+	int bricks; // Number of bricks the level started with
+	int bricksLeft; // Number left when the game ended
+	int shareTicks; // Game updates taken to knock out ANALYSESHARE percent of the bricks (-1 = never did)
+};
+
+// Structure for the work shared by the analyser threads
+struct AnalyseWork{
+	std::vector<AnalysedGame> games; // Every game to play, filled in as they are played
+	std::atomic<int> next; // The next game to hand out
+	long long maxTicks; // Most game updates a game is played for
+	int rate; // Game updates a second
+	int model; // Ball model
+};
+
+int AnalyseLevels(int games, int minutes, int threads, int rate, int model, unsigned long long seed); // Play games of every level on every core with the autopilot and report how hard each is
+void AnalyseThread(AnalyseWork *work); // Play games from the shared list until there are none left
+void AnalyseGame(Autopilot &pilot, AnalysedGame &result, long long maxTicks); // Play one game of a level with the autopilot on the selected game
+void CountAnalysedEvents(const GameEvent *events, int count); // Tally the events of a game update into the game the thread is analysing
+void PrintClearTime(int width, int ticks, long long maxTicks, int rate); // Print a clear time in seconds, or the cap it's beyond for a game that timed out
+
+// Declare and define constants
+const int DEFAULTTICKS = 1000000; // Number of game updates to run when none is given
+const int MULTIBALLTICKS = 1000; // Number of game updates for each multiball timing when none is given
+const int EXPLOSIONCHAINS = 10000; // Number of chain reactions to time when none is given
+const int LASERBULLETS = 1000; // Number of laser bullets to keep in flight when none is given
+const int LASERTICKS = 10000; // Number of game updates of laser bullets to time when none is given
+const int ANALYSEGAMES = 1000; // Number of games of each level the analyser plays when none is given
+const int ANALYSEMINUTES = 60; // Minutes of play a game is given to clear its level when none is given
+const int ANALYSESHARE = 90; // Percentage of a level's bricks the analyser also times knocking out, as the last few can take longest to reach
+
+GameState headlessGame; // The game being run
+Autopilot headlessPilot; // The autopilot playing it
+long long eventCounts[NUM_EVENTS]; // Number of each kind of event during the run
+long long bricksByCause[3]; // Number of bricks knocked out by balls, explosions and lasers
+GAMETHREADLOCAL AnalysedGame *analysing = NULL; // The game the calling thread is analysing
+
+int main(int argc, char *argv[])
+{
+	int startLevel = 1; // Level the run starts on
+	long long ticks = DEFAULTTICKS; // Number of game updates to run
+	unsigned int seed = 1; // Seed for the random number generator
+	int rate = BASETICKRATE; // Game updates a second
+	int model = BALLMODEL_LEGACY; // How the balls move
+	long long n = 0; // Counter
+	int gamesLost = 0; // Number of games lost during the run
+	int levelsCleared = 0; // Number of levels cleared during the run
+	int lastLevel; // Level before the most recent game update
+
+	if(argc > 1 && strcmp(argv[1], "collision") == 0) // If a collision benchmark was asked for...
+	{
+		InitGame(); // Load the game data
+		SetupGame(headlessGame, 1); // Set up the first board, the benchmark seeds it again
+		return CollisionBenchmark(argc > 2 ? atoi(argv[2]) : 1, argc > 3 ? atoll(argv[3]) : DEFAULTTICKS,
+			argc > 4 ? (unsigned int)strtoul(argv[4], NULL, 10) : 1);
+	}
+	if(argc > 1 && strcmp(argv[1], "explosions") == 0) // If an explosion benchmark was asked for...
+	{
+		InitGame(); // Load the game data
+		SetupGame(headlessGame, 1); // Set up the first board, the benchmark seeds it again
+		return ExplosionBenchmark(argc > 2 ? atoi(argv[2]) : 100, argc > 3 ? atoll(argv[3]) : EXPLOSIONCHAINS,
+			argc > 4 ? (unsigned int)strtoul(argv[4], NULL, 10) : 1);
+	}
+	if(argc > 1 && strcmp(argv[1], "lasers") == 0) // If a laser benchmark was asked for...
+	{
+		InitGame(); // Load the game data
+		SetupGame(headlessGame, 1); // Set up the first board, the benchmark seeds it again
+		return LaserBenchmark(argc > 2 ? atoi(argv[2]) : LASERBULLETS, argc > 3 ? atoll(argv[3]) : LASERTICKS,
+			argc > 4 ? (unsigned int)strtoul(argv[4], NULL, 10) : 1);
+	}
+	if(argc > 2 && strcmp(argv[1], "record") == 0) // If a replay is to be recorded...
+	{
+		InitGame(); // Load the game data
+		return RecordReplay(argv[2], argc > 3 ? atoll(argv[3]) : DEFAULTTICKS, argc > 4 ? strtoull(argv[4], NULL, 10) : 1,
+			argc > 5 ? atoi(argv[5]) : BASETICKRATE, argc > 6 ? atoi(argv[6]) : BALLMODEL_LEGACY);
+	}
+	if(argc > 2 && strcmp(argv[1], "replay") == 0) // If a replay is to be played...
+	{
+		InitGame(); // Load the game data
+		return ReplayBenchmark(argv[2], argc > 3 ? atoi(argv[3]) : 1);
+	}
+	if(argc > 2 && strcmp(argv[1], "save") == 0) // If a game is to be saved...
+	{
+		InitGame(); // Load the game data
+		return SaveRun(argv[2], argc > 3 ? atoll(argv[3]) : DEFAULTTICKS, argc > 4 ? strtoull(argv[4], NULL, 10) : 1,
+			argc > 5 ? atoi(argv[5]) : 1);
+	}
+	if(argc > 2 && strcmp(argv[1], "load") == 0) // If a saved game is to be timed...
+	{
+		InitGame(); // Load the game data
+		return LoadBenchmark(argv[2], argc > 3 ? atoll(argv[3]) : MULTIBALLTICKS, argc > 4 ? atoi(argv[4]) : 10000);
+	}
+	if(argc > 1 && strcmp(argv[1], "rewind") == 0) // If the rewind frames are to be timed...
+	{
+		InitGame(); // Load the game data
+		return RewindBenchmark(argc > 2 ? atoll(argv[2]) : DEFAULTTICKS / 10, argc > 3 ? strtoull(argv[3], NULL, 10) : 1,
+			argc > 4 ? atoi(argv[4]) : BASETICKRATE);
+	}
+	if(argc > 1 && strcmp(argv[1], "autopilot") == 0) // If the autopilot is to be timed...
+	{
+		InitGame(); // Load the game data
+		return AutopilotBenchmark(argc > 2 ? atoi(argv[2]) : 1, argc > 3 ? atoll(argv[3]) : DEFAULTTICKS / 10,
+			argc > 4 ? strtoull(argv[4], NULL, 10) : 1, argc > 5 ? atoi(argv[5]) : BASETICKRATE, argc > 6 ? atoi(argv[6]) : BALLMODEL_LEGACY);
+	}
+	if(argc > 1 && strcmp(argv[1], "analyse") == 0) // If the levels are to be analysed...
+	{
+		InitGame(); // Load the game data
+		return AnalyseLevels(argc > 2 ? atoi(argv[2]) : ANALYSEGAMES, argc > 3 ? atoi(argv[3]) : ANALYSEMINUTES,
+			argc > 4 ? atoi(argv[4]) : 0, argc > 5 ? atoi(argv[5]) : BASETICKRATE, argc > 6 ? atoi(argv[6]) : BALLMODEL_LEGACY,
+			argc > 7 ? strtoull(argv[7], NULL, 10) : 1);
+	}
+	if(argc > 1 && strcmp(argv[1], "multiball") == 0) // If a multiball benchmark was asked for...
+	{
+		InitGame(); // Load the game data
+		SetupGame(headlessGame, 1); // Set up the first board, the benchmark seeds it again
+		return MultiballBenchmark(argc > 2 ? atoi(argv[2]) : 0, argc > 3 ? atoll(argv[3]) : MULTIBALLTICKS,
+			argc > 4 ? (unsigned int)strtoul(argv[4], NULL, 10) : 1, argc > 5 ? atoi(argv[5]) : 1);
+	}
+
+	if(argc > 1)
+	{
+		startLevel = atoi(argv[1]);
+	}
+	if(argc > 2)
+	{
+		ticks = atoll(argv[2]);
+	}
+	if(argc > 3)
+	{
+		seed = (unsigned int)strtoul(argv[3], NULL, 10);
+	}
+	if(argc > 4)
+	{
+		rate = atoi(argv[4]);
+	}
+	if(argc > 5)
+	{
+		model = atoi(argv[5]);
+	}
+
+	InitGame(); // Load the game data
+	SetupGame(headlessGame, seed); // Set up the first board, seeded so runs can be repeated
+	if(startLevel < 1 || startLevel > GetMaxLevel()) // If the level doesn't exist...
+	{
+		fprintf(stderr, "Level %d does not exist (1 to %d)\n", startLevel, GetMaxLevel());
+		return(1);
+	}
+	if(!SetTickRate(rate)) // If the rate isn't allowed...
+	{
+		fprintf(stderr, "Rate %d is not a multiple of %d up to %d\n", rate, BASETICKRATE, MAXTICKRATE);
+		return(1);
+	}
+	if(model < 0 || model >= NUM_BALLMODELS) // If the model doesn't exist...
+	{
+		fprintf(stderr, "Ball model %d does not exist (0 to %d)\n", model, NUM_BALLMODELS - 1);
+		return(1);
+	}
+	SetBallModel(model);
+	SetupRun(startLevel);
+	game->gameHooks.events = CountEvents; // Tally what happens during the run
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	while(n < ticks)
+	{
+		lastLevel = game->level;
+		StepGame(AutoInput()); // Update the game one frame
+
+		if(game->level != lastLevel) // If the level changed...
+		{
+			levelsCleared++;
+		}
+		if(game->gameLost) // If all the lives were lost...
+		{
+			gamesLost++;
+			SetupRun(startLevel); // Start again
+		}
+		n++;
+	}
+
+	std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(finish - start).count();
+
+	printf("ticks %lld at %d a second, ball model %d\n", ticks, GetTickRate(), GetBallModel());
+	printf("seconds %.3f\n", seconds);
+	printf("ticks/s %.0f\n", seconds > 0 ? ticks / seconds : 0.0);
+	printf("simulated x realtime %.0f\n", seconds > 0 ? ticks / (double)GetTickRate() / seconds : 0.0);
+	printf("score %d, level %d, bricks left %d\n", GetScore(), GetLevel(), GetNumBricks());
+	printf("levels cleared %d, games lost %d\n", levelsCleared, gamesLost);
+	printf("bricks knocked out by balls %lld, explosions %lld, lasers %lld\n",
+		bricksByCause[CAUSE_BALL], bricksByCause[CAUSE_EXPLOSION], bricksByCause[CAUSE_LASER]);
+	printf("rebounds %lld, coins caught %lld of %lld, lives lost %lld\n", eventCounts[EVENT_REBOUND],
+		eventCounts[EVENT_COINCOLLECTED], eventCounts[EVENT_POWERUPSPAWNED], eventCounts[EVENT_LIFELOST]);
+
+	return(0);
+}
+
+void SetupRun(int startLevel) // Start a new game and move to the starting level
+{
+	StartGame(); // Start a new game on level 1
+	if(startLevel > 1)
+	{
+		ChangeLevel(startLevel - 1); // Move to the starting level
+	}
+	UnpauseGame(); // Get the game running
+}
+
+TickInput AutoInput() // Work out the input for the next game update
+{
+	TickInput input = {0, false};
+	int n = 0; // Counter
+	int target = -1; // Centre of the ball the paddle follows
+	int centre = game->paddlePos + TILESIZE + GetPaddleSize()*TILESIZE/2; // Centre of the paddle
+
+	// Follow the lowest ball and release it when it's stuck
+	while(n < game->balls.Count())
+	{
+		if(game->balls[n].stuck)
+		{
+			input.fire = true;
+		}
+		if(target == -1 || game->balls[n].y > game->balls[target].y)
+		{
+			target = n;
+		}
+		n++;
+	}
+
+	if(target != -1)
+	{
+		if(game->balls[target].x + 8 < centre - 4)
+		{
+			input.paddleDirection = -1;
+		}
+		else if(game->balls[target].x + 8 > centre + 4)
+		{
+			input.paddleDirection = 1;
+		}
+	}
+
+	return input;
+}
+
+void CountEvents(const GameEvent *events, int count) // Tally the events of a game update
+{
+	int n; // Counter
+
+	for(n = 0; n < count; n++)
+	{
+		eventCounts[events[n].type]++;
+		if(events[n].type == EVENT_BRICKDESTROYED)
+		{
+			bricksByCause[events[n].detail]++;
+		}
+	}
+}
+
+int CollisionBenchmark(int startLevel, long long steps, unsigned int seed) // Time CollisionCheck against the old pixel scan
+{
+	// Structure for one ball step to check
+	struct Probe{
+		int size, x, y, moveX, moveY;
+	};
+	const int PROBES = 4096; // Number of different ball steps to cycle through
+	Probe probes[PROBES];
+	int maps[8][16][16]; // The old int pixel maps for each ball size
+	int n = 0, m; // Counters
+	int x, y; // Counters
+	int hits = 0; // Checks that reported a collision (should be none)
+	long long i; // Counter
+
+	srand(seed);
+	SeedGame(seed);
+	if(startLevel > 1)
+	{
+		ChangeLevel(startLevel - 1); // Move to the starting level
+	}
+
+	// Rebuild the old pixel maps from the shapes
+	for(m = 0; m < 8; m++)
+	{
+		for(x = 0; x < 16; x++)
+		{
+			for(y = 0; y < 16; y++)
+			{
+				maps[m][x][y] = (GetBallShape(m).rows[y] >> x) & 1;
+			}
+		}
+	}
+
+	// Pick ball steps that don't touch anything, the case almost every step of a game is
+	game->balls[0].noRebound = 0;
+	while(n < PROBES)
+	{
+		probes[n].size = rand() % 7 + 1;
+		probes[n].x = TILESIZE + rand() % (TILESIZE*GAMEWIDTH - TILESIZE*2 - 16);
+		probes[n].y = TILESIZE + rand() % (TILESIZE*GAMEHEIGHT - TILESIZE*2 - 32);
+		probes[n].moveX = 0;
+		probes[n].moveY = 0;
+		if(rand() % 2)
+		{
+			probes[n].moveX = rand() % 2 ? 1 : -1;
+		}
+		else
+		{
+			probes[n].moveY = rand() % 2 ? 1 : -1;
+		}
+
+		game->balls[0].size = probes[n].size;
+		game->balls[0].x = probes[n].x;
+		game->balls[0].y = probes[n].y;
+		if(!LegacyCollisionScan(maps[probes[n].size], 0, 0, 0) && // If the ball isn't inside anything...
+			!LegacyCollisionScan(maps[probes[n].size], 0, probes[n].moveX, probes[n].moveY)) // And the step is clear...
+		{
+			n++;
+		}
+	}
+
+	// Time the old pixel scan
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(i = 0; i < steps; i++)
+	{
+		Probe &probe = probes[i % PROBES];
+		game->balls[0].size = probe.size;
+		game->balls[0].x = probe.x;
+		game->balls[0].y = probe.y;
+		hits += LegacyCollisionScan(maps[probe.size], 0, probe.moveX, probe.moveY);
+	}
+	double legacySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// Time the mask based check
+	start = std::chrono::steady_clock::now();
+	for(i = 0; i < steps; i++)
+	{
+		Probe &probe = probes[i % PROBES];
+		game->balls[0].size = probe.size;
+		game->balls[0].x = probe.x;
+		game->balls[0].y = probe.y;
+		hits += CollisionCheck(0, probe.moveX, probe.moveY);
+	}
+	double maskSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	printf("ball steps %lld on level %d\n", steps, GetLevel());
+	printf("pixel scan  %.1f ns/step\n", legacySeconds * 1e9 / steps);
+	printf("bit masks   %.1f ns/step\n", maskSeconds * 1e9 / steps);
+	printf("collisions reported %d\n", hits);
+
+	return(hits ? 1 : 0);
+}
+
+bool LegacyCollisionScan(int map[16][16], int num, int moveX, int moveY) // The pixel by pixel scan CollisionCheck used before ball shapes were masks
+{
+	// Does the same tests on every pixel that the old scan did, but only reports a hit instead of resolving it
+	int x, y; // Counters
+	int px, py; // Where the pixel moves to
+
+	for(y = 0; y < 16; y++)
+	{
+		for(x = 0; x < 16; x++)
+		{
+			if(map[x][y] == 1) // Check each pixel of the ball
+			{
+				px = game->balls[num].x + x + moveX;
+				py = game->balls[num].y + y + moveY;
+				if(px < TILESIZE || px > (TILESIZE*GAMEWIDTH-1) - TILESIZE || py < TILESIZE) // Borders
+				{
+					return true;
+				}
+				if(game->balls[num].noRebound <= 0 &&
+					py > (TILESIZE*GAMEHEIGHT-1) - (TILESIZE*2 - 2) && py < (TILESIZE*GAMEHEIGHT-1) - 1 &&
+					px >= GetPaddlePosition() && px <= GetPaddlePosition() + TILESIZE*(GetPaddleSize()+2) - 1) // Paddle
+				{
+					return true;
+				}
+				if(BrickAt(px/BRICKSIZE, py/BRICKSIZE)) // Bricks
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+int MultiballBenchmark(int numBalls, long long ticks, unsigned int seed, int startLevel) // Time game updates with many balls, with and without the broad phase
+{
+	const int COUNTS[4] = {10, 100, 1000, 10000}; // Numbers of balls to time when none is given
+	int n; // Counter
+	int score; // Score of the run with the broad phase
+	int mismatches = 0; // Runs where the broad phase changed the result (should be none)
+	double broadSeconds, sweepSeconds; // Time taken with and without the broad phase
+
+	if(startLevel < 1 || startLevel > GetMaxLevel()) // If the level doesn't exist...
+	{
+		fprintf(stderr, "Level %d does not exist (1 to %d)\n", startLevel, GetMaxLevel());
+		return(1);
+	}
+	if(numBalls < 0 || numBalls > MULTIBALLMAXBALLS) // If there isn't room for the balls...
+	{
+		fprintf(stderr, "Balls %d is more than %d\n", numBalls, MULTIBALLMAXBALLS);
+		return(1);
+	}
+	SetMultiball(true); // Make room for the balls
+
+	printf("ticks %lld from level %d\n", ticks, startLevel);
+	printf("%8s %14s %14s %8s %8s\n", "balls", "broad ticks/s", "sweep ticks/s", "speedup", "level");
+	for(n = 0; n < 4; n++)
+	{
+		if(numBalls > 0 && n > 0) // Only the one number was asked for
+		{
+			break;
+		}
+
+		broadSeconds = MultiballRun(numBalls > 0 ? numBalls : COUNTS[n], ticks, seed, startLevel, true);
+		score = GetScore();
+		sweepSeconds = MultiballRun(numBalls > 0 ? numBalls : COUNTS[n], ticks, seed, startLevel, false);
+		if(GetScore() != score) // Both runs should play out the same
+		{
+			mismatches++;
+		}
+
+		printf("%8d %14.0f %14.0f %7.1fx %8d\n", numBalls > 0 ? numBalls : COUNTS[n],
+			broadSeconds > 0 ? ticks / broadSeconds : 0.0, sweepSeconds > 0 ? ticks / sweepSeconds : 0.0,
+			broadSeconds > 0 ? sweepSeconds / broadSeconds : 0.0, GetLevel());
+	}
+	printf("runs that differed %d\n", mismatches);
+
+	SetBroadPhase(true);
+	return(mismatches ? 1 : 0);
+}
+
+double MultiballRun(int numBalls, long long ticks, unsigned int seed, int startLevel, bool broad) // Run the game holding numBalls in play, returns the seconds taken
+{
+	long long n; // Counter
+
+	srand(seed); // Both runs see the same balls
+	SeedGame(seed); // And the same levels
+	SetBroadPhase(broad);
+	SetupRun(startLevel);
+	TopUpBalls(numBalls);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(n = 0; n < ticks; n++)
+	{
+		StepGame(AutoInput()); // Update the game one frame
+		if(game->gameLost) // If all the lives were lost...
+		{
+			SetupRun(startLevel); // Start again
+		}
+		TopUpBalls(numBalls); // Replace the balls that fell out
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void TopUpBalls(int numBalls) // Add balls at random clear spots until there are numBalls in play
+{
+	int n; // The new ball
+	int tries; // Spots tried for the new ball
+
+	while(game->balls.Count() < numBalls && !game->balls.Full())
+	{
+		AddBall(); // Released from the paddle with the usual speed
+		n = game->balls.Count() - 1;
+		for(tries = 0; tries < 10; tries++) // Move it somewhere in the top half of the board away from the bricks
+		{
+			game->balls[n].x = TILESIZE + rand() % (TILESIZE*GAMEWIDTH - TILESIZE*2 - 16);
+			game->balls[n].y = TILESIZE + rand() % (TILESIZE*GAMEHEIGHT/2);
+			if(!BallOverlapsBricks(n))
+			{
+				break;
+			}
+		}
+		if(tries == 10) // If no clear spot was found leave it on the paddle
+		{
+			game->balls[n].x = GetPaddlePosition() + TILESIZE;
+			game->balls[n].y = 479 - 14 - (9+(game->balls[n].size));
+		}
+		if(rand() % 2) // Send half of them downwards
+		{
+			game->balls[n].speedY = -game->balls[n].speedY;
+		}
+		if(rand() % 2) // And half of them the other way
+		{
+			game->balls[n].speedX = -game->balls[n].speedX;
+		}
+		game->balls[n].lastX = game->balls[n].x;
+		game->balls[n].lastY = game->balls[n].y;
+	}
+}
+
+int ExplosionBenchmark(int percent, long long chains, unsigned int seed) // Time chain reactions of explosive bricks on a packed board
+{
+	long long i; // Counter
+	long long bricks = 0; // Bricks knocked out over all the chains
+	int x, y; // The brick that starts each chain
+	double seconds = 0; // Time spent in the chains
+	double longest = 0; // Time taken by the slowest chain
+
+	if(percent < 0 || percent > 100) // If the share isn't a percentage...
+	{
+		fprintf(stderr, "Percent %d is not 0 to 100\n", percent);
+		return(1);
+	}
+	srand(seed);
+	SeedGame(seed);
+	SetupRun(1);
+	game->balls[0].explosive = 0; // Only the bricks explode
+
+	for(i = 0; i < chains; i++)
+	{
+		PackBoard(percent);
+		x = rand() % BGAMEWIDTH;
+		y = rand() % BGAMEHEIGHT;
+		SetBrickExplosive(x, y, true); // The brick the ball hits always starts a chain
+		ClearCoins();
+		ResetExplosions();
+		RemoveBrick(x, y); // As HitBrick does before the explosion
+		TakeBrickPowerup(x, y);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		ExplodeBrick(0, x, y, true);
+		double taken = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		seconds += taken;
+		if(taken > longest)
+		{
+			longest = taken;
+		}
+		bricks += BGAMEWIDTH*BGAMEHEIGHT + 1 - GetNumBricks(); // PackBoard counts one brick over so the level never ends
+		ClearEvents(); // No game update to pass them on, so drop them
+	}
+
+	printf("chains %lld on a packed board, %d%% explosive\n", chains, percent);
+	printf("bricks knocked out per chain %.1f\n", chains > 0 ? bricks / (double)chains : 0.0);
+	printf("us/chain %.2f (slowest %.2f)\n", chains > 0 ? seconds * 1e6 / chains : 0.0, longest * 1e6);
+	printf("ns/brick %.1f\n", bricks > 0 ? seconds * 1e9 / bricks : 0.0);
+	printf("share of a 20 a second update %.3f%%\n", chains > 0 ? seconds / chains * BASETICKRATE * 100 : 0.0);
+
+	return(0);
+}
+
+void PackBoard(int percent) // Fill the board with bricks, percent of them explosive
+{
+	int x, y; // Counters
+
+	ResetNumBricks();
+	for(y = 0; y < BGAMEHEIGHT; y++)
+	{
+		for(x = 0; x < BGAMEWIDTH; x++)
+		{
+			SetBrick(x, y, 1 + rand() % brickStyles, 2 + rand() % (BRICKCOLOURS - 1));
+			SetBrickPowerup(x, y, rand() % POWERUPCHANCE ? 0 : 1 + rand() % (NUM_COMMONPOWERUPS + NUM_RAREPOWERUPS));
+			SetBrickExplosive(x, y, rand() % 100 < percent);
+		}
+	}
+	ChangeNumBricks(BGAMEWIDTH*BGAMEHEIGHT + 1); // One over, so knocking out the whole board doesn't end the level
+}
+
+int LaserBenchmark(int numBullets, long long ticks, unsigned int seed) // Time laser bullets on a packed board
+{
+	int pierce; // Bricks the bullets pass through
+	long long bricks; // Bricks knocked out in a run
+	double seconds; // Time taken by a run
+
+	if(numBullets < 1 || numBullets > MULTIBALLMAXBULLETS) // If there isn't room for the bullets...
+	{
+		fprintf(stderr, "Bullets %d is not 1 to %d\n", numBullets, MULTIBALLMAXBULLETS);
+		return(1);
+	}
+	SetMultiball(true); // Make room for the bullets
+
+	printf("ticks %lld with %d bullets in flight\n", ticks, numBullets);
+	printf("%8s %12s %14s %14s\n", "pierce", "ns/bullet", "bricks/tick", "ticks/s");
+	for(pierce = 0; pierce <= MAXLASERPIERCE; pierce++)
+	{
+		srand(seed);
+		SeedGame(seed);
+		seconds = LaserRun(numBullets, ticks, pierce, bricks);
+		printf("%8d %12.1f %14.1f %14.0f\n", pierce, seconds * 1e9 / ((double)ticks * numBullets),
+			bricks / (double)ticks, seconds > 0 ? ticks / seconds : 0.0);
+	}
+	return(0);
+}
+
+double LaserRun(int numBullets, long long ticks, int pierce, long long &bricks) // Run bullets that pass through pierce bricks, returns the seconds taken
+{
+	long long i; // Counter
+	int n; // The new bullet
+	int bricksBefore; // Bricks left before the bullets moved
+	double seconds = 0; // Time spent moving the bullets
+
+	SetupRun(1);
+	ResetBullets();
+	PackBoard(0);
+	bricks = 0;
+	for(i = 0; i < ticks; i++)
+	{
+		while(game->bullets.Count() < numBullets) // Fire new bullets from the bottom of random columns
+		{
+			n = game->bullets.Add();
+			game->bullets[n].x = TILESIZE + rand() % (TILESIZE*GAMEWIDTH - TILESIZE*2);
+			game->bullets[n].y = TILESIZE*GAMEHEIGHT-16 - rand() % BRICKSIZE;
+			game->bullets[n].remove = false;
+			game->bullets[n].pierce = pierce;
+			game->bullets[n].lastX = game->bullets[n].x;
+			game->bullets[n].lastY = game->bullets[n].y;
+		}
+		if(GetNumBricks() < BGAMEWIDTH*BGAMEHEIGHT/2) // Keep the board packed
+		{
+			PackBoard(0);
+		}
+		bricksBefore = GetNumBricks();
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		MoveBullets();
+		seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		bricks += bricksBefore - GetNumBricks();
+		ClearCoins(); // Keep the coins from filling up
+		ClearEvents(); // No game update to pass them on, so drop them
+	}
+	return seconds;
+}
+
+int RecordReplay(const char *filename, long long ticks, unsigned long long seed, int rate, int model) // Play a game with AutoInput and save it as a replay
+{
+	Replay replay; // The game recorded
+
+	SetupGame(headlessGame, seed);
+	if(!SetTickRate(rate)) // If the rate isn't allowed...
+	{
+		fprintf(stderr, "Rate %d is not a multiple of %d up to %d\n", rate, BASETICKRATE, MAXTICKRATE);
+		return(1);
+	}
+	if(model < 0 || model >= NUM_BALLMODELS) // If the model doesn't exist...
+	{
+		fprintf(stderr, "Ball model %d does not exist (0 to %d)\n", model, NUM_BALLMODELS - 1);
+		return(1);
+	}
+	SetBallModel(model);
+	StartRecording(replay, seed);
+	UnpauseGame(); // Get the game running
+
+	while(replay.ticks < ticks && !game->gameLost)
+	{
+		RecordStep(replay, AutoInput());
+	}
+	FinishRecording(replay);
+
+	if(!SaveReplay(replay, filename))
+	{
+		fprintf(stderr, "Could not write %s\n", filename);
+		return(1);
+	}
+	printf("recorded %d ticks at %d a second, ball model %d, seed %llu\n", replay.ticks, GetTickRate(), GetBallModel(), seed);
+	printf("score %d, level %d%s\n", GetScore(), GetLevel(), game->gameLost ? ", game lost" : "");
+	printf("replay %u bytes of records, %.2f bytes a second of play\n", (unsigned int)replay.data.size(),
+		replay.ticks > 0 ? replay.data.size() * (double)GetTickRate() / replay.ticks : 0.0);
+
+	return(0);
+}
+
+int ReplayBenchmark(const char *filename, int repeats) // Play a replay back, checking and timing it
+{
+	Replay replay; // The game recorded
+	ReplayResult result; // How the last play back went
+	int n; // Counter
+	int mismatches = 0; // Number of play backs that didn't play out as recorded
+
+	if(!LoadReplay(replay, filename))
+	{
+		fprintf(stderr, "Could not read a replay from %s\n", filename);
+		return(1);
+	}
+	if(replay.levelPackHash != levelPackHash)
+	{
+		fprintf(stderr, "%s was recorded on different levels (%08x, these are %08x)\n", filename, replay.levelPackHash, levelPackHash);
+		return(1);
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for(n = 0; n < repeats; n++)
+	{
+		PlayReplay(headlessGame, replay, result);
+		if(result.firstMismatch != -1)
+		{
+			mismatches++;
+		}
+	}
+
+	std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(finish - start).count();
+
+	printf("replay %d ticks at %d a second, ball model %d, seed %llu, played %d times\n", replay.ticks, replay.tickRate,
+		replay.ballModel, replay.seed, repeats);
+	printf("seconds %.3f\n", seconds);
+	printf("ticks/s %.0f\n", seconds > 0 ? (double)replay.ticks * repeats / seconds : 0.0);
+	printf("score %d, level %d\n", result.score, result.level);
+	printf("checksums %d, ", result.checks);
+	if(mismatches == 0)
+	{
+		printf("all matched\n");
+		return(0);
+	}
+	printf("first mismatch after %d ticks, %d of %d play backs differed\n", result.firstMismatch, mismatches, repeats);
+
+	return(1);
+}
+
+int SaveRun(const char *filename, long long ticks, unsigned long long seed, int startLevel) // Play a game with AutoInput and save it part way through
+{
+	long long n = 0; // Counter
+
+	SetupGame(headlessGame, seed);
+	if(startLevel < 1 || startLevel > GetMaxLevel()) // If the level doesn't exist...
+	{
+		fprintf(stderr, "Level %d does not exist (1 to %d)\n", startLevel, GetMaxLevel());
+		return(1);
+	}
+	SetupRun(startLevel);
+	while(n < ticks && !game->gameLost)
+	{
+		StepGame(AutoInput());
+		n++;
+	}
+
+	if(!SaveGameFile(filename))
+	{
+		fprintf(stderr, "Could not write %s\n", filename);
+		return(1);
+	}
+	printf("saved after %lld ticks, score %d, level %d, bricks left %d, balls %d%s\n", n, GetScore(), GetLevel(),
+		GetNumBricks(), game->balls.Count(), game->gameLost ? ", game lost" : "");
+
+	return(0);
+}
+
+int LoadBenchmark(const char *filename, long long ticks, int repeats) // Time saving and loading a saved game and check it plays on the same
+{
+	std::vector<unsigned char> saved; // The game as saved
+	std::vector<unsigned char> resaved; // The game saved again after loading it
+	GameState copy; // The game loaded a second time, to play on from
+	unsigned int checksums[2]; // Checksum of the game after playing on from each load
+	long long n; // Counter
+	int run; // Counter
+
+	SetupGame(headlessGame, 1); // Loading needs a game to load into
+	if(!LoadGameFile(headlessGame, filename))
+	{
+		fprintf(stderr, "Could not load a saved game of these levels from %s\n", filename);
+		return(1);
+	}
+	SaveSnapshot(saved);
+	printf("save %u bytes, level %d, score %d, balls %d\n", (unsigned int)saved.size(), GetLevel(), GetScore(), game->balls.Count());
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(run = 0; run < repeats; run++)
+	{
+		SaveSnapshot(resaved);
+	}
+	std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+	for(run = 0; run < repeats; run++)
+	{
+		LoadSnapshot(headlessGame, &saved[0], saved.size());
+	}
+	std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+
+	// Play on from the save twice, once straight from the file and once after another save and load,
+	// and both should play out the same
+	SaveSnapshot(resaved);
+	SetupGame(copy, 1);
+	LoadSnapshot(copy, &resaved[0], resaved.size());
+	for(run = 0; run < 2; run++)
+	{
+		SelectGame(run == 0 ? headlessGame : copy);
+		UnpauseGame();
+		for(n = 0; n < ticks && !game->gameLost; n++)
+		{
+			StepGame(AutoInput());
+		}
+		checksums[run] = GameChecksum();
+	}
+
+	printf("save %.2f microseconds, load %.2f microseconds\n",
+		std::chrono::duration<double>(middle - start).count() * 1000000 / repeats,
+		std::chrono::duration<double>(finish - middle).count() * 1000000 / repeats);
+	if(saved != resaved || checksums[0] != checksums[1])
+	{
+		printf("played on %lld ticks, %s\n", ticks, saved != resaved ? "saved again differently" : "checksums differ");
+		return(1);
+	}
+	printf("played on %lld ticks, all matched\n", ticks);
+
+	return(0);
+}
+
+int RewindBenchmark(long long ticks, unsigned long long seed, int rate) // Time keeping rewind frames and check every frame kept loads as the game was
+{
+	RewindBuffer rewind; // The frames of the game
+	GameState loaded; // Frames are loaded into this to check them
+	std::vector<unsigned int> checksums(REWINDFRAMES); // Checksum of the game as each frame kept was recorded
+	size_t keyframeBytes = 0, deltaBytes = 0; // Bytes of the keyframes and deltas kept
+	int keyframes = 0; // Number of keyframes kept
+	int mismatches = 0; // Number of frames that didn't load as the game was
+	int steps = 0; // Number of frames stepped back through
+	long long n; // Counter
+	long long frame; // Counter
+
+	SetupGame(headlessGame, seed);
+	if(!SetTickRate(rate)) // If the rate isn't allowed...
+	{
+		fprintf(stderr, "Rate %d is not a multiple of %d up to %d\n", rate, BASETICKRATE, MAXTICKRATE);
+		return(1);
+	}
+	SetupRun(1);
+	ResetRewind(rewind);
+	RecordRewind(rewind); // The start of the game
+	checksums[0] = GameChecksum();
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(n = 0; n < ticks; n++)
+	{
+		StepGame(AutoInput());
+		if(game->gameLost) // If all the lives were lost...
+		{
+			SetupRun(1); // Start again, rewinding back into the lost game
+		}
+		RecordRewind(rewind);
+		if(game->tickPhase == 0)
+		{
+			checksums[(rewind.next - 1) % REWINDFRAMES] = GameChecksum();
+		}
+	}
+	std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+
+	// Load every frame kept, oldest first
+	SetupGame(loaded, seed);
+	for(frame = rewind.first; frame < rewind.next; frame++)
+	{
+		if(!LoadRewindFrame(rewind, loaded, frame) || GameChecksum() != checksums[frame % REWINDFRAMES])
+		{
+			mismatches++;
+		}
+		if(rewind.frames[frame % REWINDFRAMES].keyframe == frame)
+		{
+			keyframes++;
+			keyframeBytes += rewind.frames[frame % REWINDFRAMES].size;
+		}
+		else
+		{
+			deltaBytes += rewind.frames[frame % REWINDFRAMES].size;
+		}
+	}
+	std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+
+	printf("ticks %lld at %d a second, frames kept %lld (%.1f seconds of play)\n", ticks, GetTickRate(),
+		rewind.next - rewind.first, (rewind.next - rewind.first) / (double)BASETICKRATE);
+	printf("store %u bytes used of %d, keyframes %d averaging %.0f bytes, deltas averaging %.0f bytes\n",
+		(unsigned int)rewind.used, REWINDBYTES, keyframes, keyframes > 0 ? keyframeBytes / (double)keyframes : 0.0,
+		rewind.next - rewind.first > keyframes ? deltaBytes / (double)(rewind.next - rewind.first - keyframes) : 0.0);
+	printf("record %.2f microseconds a tick, load %.2f microseconds a frame\n",
+		std::chrono::duration<double>(middle - start).count() * 1000000 / (ticks > 0 ? ticks : 1),
+		std::chrono::duration<double>(finish - middle).count() * 1000000 / (rewind.next > rewind.first ? rewind.next - rewind.first : 1));
+
+	// Step back through the frames from the game being played, as the player would
+	SelectGame(headlessGame);
+	while(StepBack(rewind, headlessGame))
+	{
+		if(GameChecksum() != checksums[(rewind.next - 1) % REWINDFRAMES])
+		{
+			mismatches++;
+		}
+		steps++;
+	}
+	printf("stepped back %d frames, ", steps);
+	if(mismatches == 0)
+	{
+		printf("all matched\n");
+		return(0);
+	}
+	printf("%d frames didn't load as the game was\n", mismatches);
+
+	return(1);
+}
+
+int AutopilotBenchmark(int startLevel, long long ticks, unsigned long long seed, int rate, int model) // Play with the autopilot and with AutoInput, and time the landing predictions
+{
+	SetupGame(headlessGame, seed);
+	if(startLevel < 1 || startLevel > GetMaxLevel()) // If the level doesn't exist...
+	{
+		fprintf(stderr, "Level %d does not exist (1 to %d)\n", startLevel, GetMaxLevel());
+		return(1);
+	}
+	if(!SetTickRate(rate)) // If the rate isn't allowed...
+	{
+		fprintf(stderr, "Rate %d is not a multiple of %d up to %d\n", rate, BASETICKRATE, MAXTICKRATE);
+		return(1);
+	}
+	if(model < 0 || model >= NUM_BALLMODELS) // If the model doesn't exist...
+	{
+		fprintf(stderr, "Ball model %d does not exist (0 to %d)\n", model, NUM_BALLMODELS - 1);
+		return(1);
+	}
+
+	printf("ticks %lld at %d a second, ball model %d, from level %d\n", ticks, rate, model, startLevel);
+	AutopilotRun(startLevel, ticks, seed, rate, model, false);
+	AutopilotRun(startLevel, ticks, seed, rate, model, true);
+
+	return(0);
+}
+
+void AutopilotRun(int startLevel, long long ticks, unsigned long long seed, int rate, int model, bool pilotOn) // Play for ticks with the autopilot or AutoInput and report how it went
+{
+	TickInput input; // The input for the game update
+	std::chrono::steady_clock::time_point before, after; // Around each call to the autopilot
+	double predicting = 0; // Seconds spent working out the autopilot's input
+	double slowest = 0; // Longest the autopilot took over one game update
+	long long expectTick = -1; // Game tick a ball was predicted to start the game update it lands in on (-1 = no prediction being checked)
+	PoolHandle expectBall = {-1, 0}; // The ball
+	unsigned int expectFrom = 0; // Hash of the ball as it was predicted to be then
+	int landings = 0, exact = 0; // Predictions checked, and those that came true to the pixel
+	int gamesLost = 0; // Number of games lost during the run
+	int levelsCleared = 0; // Number of levels cleared during the run
+	int lastLevel; // Level before the most recent game update
+	long long n; // Counter
+
+	SetupGame(headlessGame, seed);
+	SetTickRate(rate);
+	SetBallModel(model);
+	SetupRun(startLevel);
+	game->gameHooks.events = CountEvents; // Tally what happens during the run
+	memset(eventCounts, 0, sizeof(eventCounts));
+	memset(bricksByCause, 0, sizeof(bricksByCause));
+	ResetAutopilot(headlessPilot, seed);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(n = 0; n < ticks; n++)
+	{
+		if(!pilotOn)
+		{
+			input = AutoInput();
+		}
+		else
+		{
+			// Check a landing predicted for a ball as it starts the game update it lands in, before the paddle can touch it
+			if(expectTick == game->gameTick && game->balls.Find(expectBall) != -1)
+			{
+				landings++;
+				if(FlightHash(game->balls[game->balls.Find(expectBall)]) == expectFrom)
+				{
+					exact++;
+				}
+				expectTick = -1;
+			}
+
+			before = std::chrono::steady_clock::now();
+			input = AutopilotInput(headlessPilot);
+			after = std::chrono::steady_clock::now();
+			predicting += std::chrono::duration<double>(after - before).count();
+			if(std::chrono::duration<double>(after - before).count() > slowest)
+			{
+				slowest = std::chrono::duration<double>(after - before).count();
+			}
+
+			if(expectTick <= game->gameTick && headlessPilot.landingTicks > 0) // Check the next ball being caught
+			{
+				expectTick = game->gameTick + headlessPilot.landingTicks - 1;
+				expectBall = headlessPilot.landingBall;
+				expectFrom = headlessPilot.landingFrom;
+			}
+		}
+
+		lastLevel = game->level;
+		StepGame(input);
+		if(game->level != lastLevel) // If the level changed...
+		{
+			levelsCleared++;
+		}
+		if(game->level != lastLevel) // The ball has gone with the old level
+		{
+			expectTick = -1;
+		}
+		if(game->gameLost) // If all the lives were lost...
+		{
+			gamesLost++;
+			SetupRun(startLevel); // Start again
+			expectTick = -1;
+		}
+	}
+	std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(finish - start).count();
+
+	printf("%s: levels cleared %d, games lost %d, lives lost %lld, coins caught %lld of %lld, bricks knocked out %lld\n",
+		pilotOn ? "autopilot" : "ball follower", levelsCleared, gamesLost, eventCounts[EVENT_LIFELOST],
+		eventCounts[EVENT_COINCOLLECTED], eventCounts[EVENT_POWERUPSPAWNED],
+		bricksByCause[CAUSE_BALL] + bricksByCause[CAUSE_EXPLOSION] + bricksByCause[CAUSE_LASER]);
+	if(pilotOn)
+	{
+		printf("  predicting %.3f of %.3f seconds, %.2f microseconds a tick (slowest %.1f)\n", predicting, seconds,
+			predicting * 1000000 / (ticks > 0 ? ticks : 1), slowest * 1000000);
+		printf("  balls followed %.3f a tick, %.1f game updates each, landings taken from a path kept %.2f a tick\n",
+			headlessPilot.predictions / (double)(ticks > 0 ? ticks : 1),
+			headlessPilot.predictions > 0 ? headlessPilot.steps / (double)headlessPilot.predictions : 0.0,
+			headlessPilot.reused / (double)(ticks > 0 ? ticks : 1));
+		printf("  landings of the balls caught predicted exactly %d of %d\n", exact, landings);
+	}
+}
+
+int AnalyseLevels(int games, int minutes, int threads, int rate, int model, unsigned long long seed) // Play games of every level on every core with the autopilot and report how hard each is
+{
+	AnalyseWork work; // The games to play
+	std::vector<std::thread> workers; // The threads playing them
+	std::vector<int> clearTimes; // Game updates taken by the games of a level that weren't lost (past maxTicks = timed out)
+	std::vector<int> shareTimes; // Game updates taken by them to knock out ANALYSESHARE percent of the bricks (the same)
+	long long totalTicks = 0; // Game updates played by every game
+	int level, n; // Counters
+	int first; // First game of the level
+	int cleared, lost, livesLost, coinsSpawned, coinsCaught, greyLoops, looped; // Totals for a level
+	long long bricks, bricksLeft; // Bricks the games of a level started with and had left
+
+	if(games < 1 || minutes < 1)
+	{
+		fprintf(stderr, "At least one game of at least one minute is needed\n");
+		return(1);
+	}
+	if(rate < BASETICKRATE || rate > MAXTICKRATE || rate % BASETICKRATE) // If the rate isn't allowed...
+	{
+		fprintf(stderr, "Rate %d is not a multiple of %d up to %d\n", rate, BASETICKRATE, MAXTICKRATE);
+		return(1);
+	}
+	if(model < 0 || model >= NUM_BALLMODELS) // If the model doesn't exist...
+	{
+		fprintf(stderr, "Ball model %d does not exist (0 to %d)\n", model, NUM_BALLMODELS - 1);
+		return(1);
+	}
+	if(threads < 1) // Use every core if no number is given
+	{
+		threads = (int)std::thread::hardware_concurrency();
+		if(threads < 1)
+		{
+			threads = 1;
+		}
+	}
+
+	// Every game has its own seed, worked out from the seed given, the level and the game, so the results
+	// are the same whichever thread plays it and however many threads there are
+	work.games.resize((size_t)GetMaxLevel() * games);
+	for(level = 1; level <= GetMaxLevel(); level++)
+	{
+		for(n = 0; n < games; n++)
+		{
+			AnalysedGame &result = work.games[(size_t)(level - 1) * games + n];
+			result.level = level;
+			result.seed = seed * 1000003 + (unsigned long long)level * 7919 * games + n;
+		}
+	}
+	work.next = 0;
+	work.maxTicks = (long long)minutes * 60 * rate;
+	work.rate = rate;
+	work.model = model;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(n = 0; n < threads; n++)
+	{
+		workers.push_back(std::thread(AnalyseThread, &work));
+	}
+	for(n = 0; n < threads; n++)
+	{
+		workers[n].join();
+	}
+	std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(finish - start).count();
+
+	printf("%d levels, %d games each of up to %d minutes at %d a second, ball model %d, %d threads\n",
+		GetMaxLevel(), games, minutes, rate, model, threads);
+	printf("level  cleared  lost  timed out   clear time in seconds, not lost (10%% / median / 90%% / max)   %d%% out (median / 90%%)   bricks out   lives lost   coins caught   grey loops (games)\n",
+		ANALYSESHARE);
+	for(level = 1; level <= GetMaxLevel(); level++)
+	{
+		first = (level - 1) * games;
+		cleared = lost = livesLost = coinsSpawned = coinsCaught = greyLoops = looped = 0;
+		bricks = bricksLeft = 0;
+		clearTimes.clear();
+		shareTimes.clear();
+		for(n = first; n < first + games; n++)
+		{
+			const AnalysedGame &result = work.games[n];
+			// A game that timed out would have cleared the level some time after the cap, if at all, so it
+			// counts as slower than every game that cleared it rather than being left out
+			if(result.cleared)
+			{
+				cleared++;
+				clearTimes.push_back(result.ticks);
+			}
+			else if(result.lost)
+			{
+				lost++;
+			}
+			else
+			{
+				clearTimes.push_back((int)work.maxTicks + 1);
+			}
+			// A game lost before it knocked out the share is left out the same way, but one lost after still counts
+			if(result.shareTicks >= 0)
+			{
+				shareTimes.push_back(result.shareTicks);
+			}
+			else if(!result.lost)
+			{
+				shareTimes.push_back((int)work.maxTicks + 1);
+			}
+			livesLost += result.livesLost;
+			coinsSpawned += result.coinsSpawned;
+			coinsCaught += result.coinsCaught;
+			greyLoops += result.greyLoops;
+			if(result.greyLoops > 0)
+			{
+				looped++;
+			}
+			bricks += result.bricks;
+			bricksLeft += result.bricksLeft;
+			totalTicks += result.ticks;
+		}
+		std::sort(clearTimes.begin(), clearTimes.end());
+		std::sort(shareTimes.begin(), shareTimes.end());
+
+		printf("%5d  %6.1f%%  %4.1f%%  %8.1f%%  ", level, 100.0 * cleared / games, 100.0 * lost / games,
+			100.0 * (games - cleared - lost) / games);
+		if(clearTimes.empty())
+		{
+			printf("%61s", "all lost");
+		}
+		else
+		{
+			PrintClearTime(10, clearTimes[clearTimes.size() / 10], work.maxTicks, rate);
+			printf(" / ");
+			PrintClearTime(8, clearTimes[clearTimes.size() / 2], work.maxTicks, rate);
+			printf(" / ");
+			PrintClearTime(8, clearTimes[clearTimes.size() * 9 / 10], work.maxTicks, rate);
+			printf(" / ");
+			PrintClearTime(8, clearTimes.back(), work.maxTicks, rate);
+			printf("                  ");
+		}
+		if(shareTimes.empty())
+		{
+			printf("%22s", "all lost");
+		}
+		else
+		{
+			PrintClearTime(11, shareTimes[shareTimes.size() / 2], work.maxTicks, rate);
+			printf(" / ");
+			PrintClearTime(8, shareTimes[shareTimes.size() * 9 / 10], work.maxTicks, rate);
+		}
+		printf("   %8.1f%%   %5.2f/game   %5.1f%% of %5.1f   %6.2f/game (%.1f%%)\n", bricks > 0 ? 100.0 * (bricks - bricksLeft) / bricks : 100.0,
+			livesLost / (double)games, coinsSpawned > 0 ? 100.0 * coinsCaught / coinsSpawned : 0.0, coinsSpawned / (double)games,
+			greyLoops / (double)games, 100.0 * looped / games);
+	}
+	printf("seconds %.3f, games/s %.0f, ticks/s %.0f (%.0f a thread), simulated x realtime %.0f\n", seconds,
+		seconds > 0 ? work.games.size() / seconds : 0.0, seconds > 0 ? totalTicks / seconds : 0.0,
+		seconds > 0 ? totalTicks / seconds / threads : 0.0, seconds > 0 ? totalTicks / (double)rate / seconds : 0.0);
+
+	return(0);
+}
+
+void AnalyseThread(AnalyseWork *work) // Play games from the shared list until there are none left
+{
+	GameState state; // This thread's game, selected on this thread only
+	Autopilot pilot; // Its autopilot
+	int n; // The game being played
+
+	SetupGame(state, 0); // Selects the game for this thread
+	SetTickRate(work->rate);
+	SetBallModel(work->model);
+	game->gameHooks.events = CountAnalysedEvents;
+
+	// Games are handed out one at a time, so a thread given slow games doesn't hold up the rest
+	for(n = work->next++; n < (int)work->games.size(); n = work->next++)
+	{
+		AnalyseGame(pilot, work->games[n], work->maxTicks);
+	}
+}
+
+void AnalyseGame(Autopilot &pilot, AnalysedGame &result, long long maxTicks) // Play one game of a level with the autopilot on the selected game
+{
+	result.ticks = 0;
+	result.cleared = false;
+	result.lost = false;
+	result.livesLost = 0;
+	result.coinsSpawned = 0;
+	result.coinsCaught = 0;
+	result.greyLoops = 0;
+
+	SeedGame(result.seed); // Before the level is built, so its powerup coins come from the game's seed
+	SetupRun(result.level);
+	ResetAutopilot(pilot, result.seed);
+	result.bricks = game->numBricks;
+	result.bricksLeft = game->numBricks;
+	result.shareTicks = -1;
+	analysing = &result; // Count the events of this game from here on
+
+	while(result.ticks < maxTicks)
+	{
+		StepGame(AutopilotInput(pilot));
+		result.ticks++;
+		if(game->level != result.level) // If the level was cleared...
+		{
+			result.cleared = true;
+			result.bricksLeft = 0;
+			if(result.shareTicks < 0)
+			{
+				result.shareTicks = result.ticks;
+			}
+			break;
+		}
+		if(game->gameLost) // If all the lives were lost...
+		{
+			result.lost = true;
+			break;
+		}
+		result.bricksLeft = game->numBricks;
+		if(result.shareTicks < 0 && (long long)(result.bricks - result.bricksLeft) * 100 >= (long long)result.bricks * ANALYSESHARE)
+		{
+			result.shareTicks = result.ticks;
+		}
+	}
+	analysing = NULL;
+}
+
+void CountAnalysedEvents(const GameEvent *events, int count) // Tally the events of a game update into the game the thread is analysing
+{
+	int n; // Counter
+
+	if(analysing == NULL)
+	{
+		return;
+	}
+	for(n = 0; n < count; n++)
+	{
+		switch(events[n].type)
+		{
+		case EVENT_LIFELOST:
+		case EVENT_GAMELOST:
+			analysing->livesLost++;
+			break;
+		case EVENT_POWERUPSPAWNED:
+			analysing->coinsSpawned++;
+			break;
+		case EVENT_COINCOLLECTED:
+			analysing->coinsCaught++;
+			break;
+		case EVENT_GREYLOOPBROKEN:
+			analysing->greyLoops++;
+			break;
+		}
+	}
+}
+
+void PrintClearTime(int width, int ticks, long long maxTicks, int rate) // Print a clear time in seconds, or the cap it's beyond for a game that timed out
+{
+	char text[32]; // The time with the >= in front
+
+	if(ticks > maxTicks)
+	{
+		snprintf(text, sizeof(text), ">=%.1f", maxTicks / (double)rate);
+		printf("%*s", width, text);
+	}
+	else
+	{
+		printf("%*.1f", width, ticks / (double)rate);
+	}
+}
@@ -0,0 +1,209 @@
+// Pool.h
+// A store for a kind of game object (balls, coins, explosions or bullets) with room for a set number of them
+// The objects in use are kept packed at the front, so they can be looped over like an array from 0 to Count(),
+//   and removing one moves the last one into its place instead of shifting everything after it down
+// As objects move about when others are removed, something that needs to find the same object again later
+//   keeps a handle to it, which stops finding it once it has been removed even if its slot is reused
+
+#ifndef POOL_H
+#define POOL_H
+#pragma once
+
+// Include standard library
+#include <vector>
+
+// Structure for a handle to an object in a pool
+struct PoolHandle{
+	int slot; // Slot the object was given when it was added (-1 = no object)
+	unsigned int generation; // Number of times the slot had been emptied when the object was added
+};
+
+template<typename T>
+class Pool
+{
+private:
+	std::vector<T> items; // The objects, those in use packed at the front
+	std::vector<int> slotOf; // The slot of each object in use
+	std::vector<int> itemOf; // The object in each slot
+	std::vector<unsigned int> generations; // Number of times each slot has been emptied
+	std::vector<int> freeSlots; // Slots not in use
+	int count; // Number of objects in use
+
+public:
+	// Constructor
+	Pool() : count(0) {}
+
+	// Set the number of objects there is room for, removing any in use
+	void Resize(int capacity)
+	{
+		int n; // Counter
+
+		// The objects in use are removed, so any handles to them go out of date, and the generations of slots
+		// beyond the new capacity are kept in case it grows again, so no old handle ever finds a new object
+		for(n = 0; n < count; n++)
+		{
+			generations[slotOf[n]]++;
+		}
+		if((int)generations.size() < capacity)
+		{
+			generations.resize(capacity, 0);
+		}
+
+		items.assign(capacity, T());
+		slotOf.assign(capacity, -1);
+		itemOf.assign(capacity, -1);
+		freeSlots.resize(capacity);
+		for(n = 0; n < capacity; n++)
+		{
+			freeSlots[n] = capacity - 1 - n; // Hand out the low slots first
+		}
+		count = 0;
+	}
+
+	// Remove all the objects
+	void Clear()
+	{
+		while(count > 0)
+		{
+			Remove(count - 1);
+		}
+	}
+
+	// Add a blank object, returns where it is or -1 if there is no room
+	int Add()
+	{
+		int slot; // Slot for the new object
+
+		if(freeSlots.empty())
+		{
+			return -1;
+		}
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+		itemOf[slot] = count;
+		slotOf[count] = slot;
+		items[count] = T();
+		return count++;
+	}
+
+	// Remove the object at index, moving the last object into its place
+	void Remove(int index)
+	{
+		int last = count - 1; // The object that fills the gap
+
+		if(index < 0 || index > last)
+		{
+			return;
+		}
+		generations[slotOf[index]]++; // Any handles to the object are now out of date
+		freeSlots.push_back(slotOf[index]);
+		if(index != last)
+		{
+			items[index] = items[last];
+			slotOf[index] = slotOf[last];
+			itemOf[slotOf[index]] = index;
+		}
+		slotOf[last] = -1;
+		items[last] = T();
+		count--;
+	}
+
+	// Number of objects in use
+	int Count() const
+	{
+		return count;
+	}
+
+	// Number of objects there is room for
+	int Capacity() const
+	{
+		return (int)items.size();
+	}
+
+	// Is there no room for another object
+	bool Full() const
+	{
+		return freeSlots.empty();
+	}
+
+	// Returns a handle to the object at index
+	PoolHandle Handle(int index) const
+	{
+		PoolHandle handle = {-1, 0};
+
+		if(index >= 0 && index < count)
+		{
+			handle.slot = slotOf[index];
+			handle.generation = generations[handle.slot];
+		}
+		return handle;
+	}
+
+	// Returns where the object a handle points to is now (-1 = it has been removed)
+	int Find(PoolHandle handle) const
+	{
+		if(handle.slot < 0 || handle.slot >= (int)itemOf.size() || generations[handle.slot] != handle.generation)
+		{
+			return -1;
+		}
+		return itemOf[handle.slot];
+	}
+
+	// Number of times a slot has been emptied (for saving the pool)
+	unsigned int SlotGeneration(int slot) const
+	{
+		return generations[slot];
+	}
+
+	// The slots not in use, the next to be handed out last (for saving the pool)
+	const std::vector<int> &FreeSlots() const
+	{
+		return freeSlots;
+	}
+
+	// Put the pool back as it was saved, with the objects in use in the given slots, returns false if they don't fit
+	// The objects are left blank to be filled in, and handles saved with the pool find them again
+	bool Restore(const std::vector<int> &slots, const std::vector<unsigned int> &slotGenerations, const std::vector<int> &free)
+	{
+		std::vector<int> used(items.size(), 0); // Times each slot is listed
+		size_t n; // Counter
+
+		if(slotGenerations.size() != items.size() || slots.size() + free.size() != items.size())
+		{
+			return false;
+		}
+		for(n = 0; n < slots.size() + free.size(); n++)
+		{
+			int slot = n < slots.size() ? slots[n] : free[n - slots.size()]; // Slot listed
+			if(slot < 0 || slot >= (int)items.size() || used[slot]++)
+			{
+				return false; // Every slot must be listed once
+			}
+		}
+
+		items.assign(items.size(), T());
+		slotOf.assign(items.size(), -1);
+		itemOf.assign(items.size(), -1);
+		for(n = 0; n < slots.size(); n++)
+		{
+			slotOf[n] = slots[n];
+			itemOf[slots[n]] = (int)n;
+		}
+		generations = slotGenerations;
+		freeSlots = free;
+		count = (int)slots.size();
+		return true;
+	}
+
+	// Access the object at index
+	T &operator[](int index)
+	{
+		return items[index];
+	}
+	const T &operator[](int index) const
+	{
+		return items[index];
+	}
+};
+
+#endif
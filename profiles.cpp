@@ -0,0 +1,100 @@
+// Profiles.cpp
+// The parts of the paddle and the powerup coins that can touch each other or a ball
+
+// Include the profiles header
+#include "profiles.h"
+
+PaddleProfile paddleProfiles[NUM_PADDLEPROFILES][MAXPADDLESIZE+1]; // Profiles for each kind of contact and paddle size
+signed char coinBottoms[8][16]; // Lowest pixel of each column of each coin rotation (-1 = empty column)
+
+void BuildPaddleProfile(PaddleProfile &profile, int size, int top, int bottom, int extraRight) // Build one paddle profile
+{
+	int width = TILESIZE*(size+2); // Pixels across the paddle
+	int row; // Counter
+	int inset; // Pixels the paddle's ends are rounded in by on a row
+
+	profile.top = top;
+	profile.rows = bottom - top + 1;
+	for(row = 0; row < profile.rows; row++)
+	{
+		// The paddle varies in length as it is rounded
+		if(row >= 2 && row <= profile.rows - 3) // In line with the longest part of the paddle
+		{
+			inset = 0;
+		}
+		else if(row >= 1 && row <= profile.rows - 2) // In line with the second longest sections of the paddle
+		{
+			inset = 1;
+		}
+		else // In line with the narrowest sections of the paddle
+		{
+			inset = 3;
+		}
+		profile.first[row] = inset;
+		profile.last[row] = width - 1 - inset + extraRight;
+	}
+}
+
+void BuildPaddleProfiles() // Build the paddle profiles for every kind of contact and paddle size
+{
+	const int top = (TILESIZE*GAMEHEIGHT-1) - (TILESIZE*2 - 2) + 1; // First row a ball can touch the paddle on
+	const int bottom = (TILESIZE*GAMEHEIGHT-1) - 2; // Last row a ball can touch the paddle on
+	int size; // Counter
+
+	for(size = 0; size <= MAXPADDLESIZE; size++)
+	{
+		BuildPaddleProfile(paddleProfiles[PADDLEPROFILE_ACROSS][size], size, top, bottom, 0);
+		// A ball moving down stops a row short, a coin reaches a row higher
+		// and the moving paddle reaches a pixel further to the right
+		BuildPaddleProfile(paddleProfiles[PADDLEPROFILE_DOWN][size], size, top, bottom - 1, 0);
+		BuildPaddleProfile(paddleProfiles[PADDLEPROFILE_COIN][size], size, top - 1, bottom, 0);
+		BuildPaddleProfile(paddleProfiles[PADDLEPROFILE_PUSH][size], size, top, bottom, 1);
+	}
+}
+
+void BuildCoinBottoms() // Find the lowest pixel of each column of each coin rotation from the coin map
+{
+	int rotation, x, y; // Counters
+
+	for(rotation = 0; rotation < 8; rotation++)
+	{
+		for(x = 0; x < 16; x++)
+		{
+			y = 15;
+			while(y >= 0 && !coinMap[rotation][x][y]) // Find the lowest active pixel
+			{
+				y--;
+			}
+			coinBottoms[rotation][x] = (signed char)y;
+		}
+	}
+}
+
+const PaddleProfile &GetPaddleProfile(int kind, int size) // Returns the paddle profile for a kind of contact and paddle size
+{
+	if(size < 0)
+	{
+		size = 0;
+	}
+	if(size > MAXPADDLESIZE)
+	{
+		size = MAXPADDLESIZE;
+	}
+	return paddleProfiles[kind][size];
+}
+
+bool OnPaddle(const PaddleProfile &profile, int paddleLeft, int px, int py) // Does pixel px,py touch a paddle with its left end at paddleLeft
+{
+	int row = py - profile.top; // Row of the profile the pixel is on
+
+	if(row < 0 || row >= profile.rows) // If the pixel isn't in line with the paddle...
+	{
+		return false;
+	}
+	return px >= paddleLeft + profile.first[row] && px <= paddleLeft + profile.last[row];
+}
+
+int CoinBottom(int rotation, int x) // Returns the lowest pixel in column x of a coin rotation (-1 = empty column)
+{
+	return coinBottoms[rotation][x];
+}
@@ -0,0 +1,41 @@
+// Profiles.h
+// The parts of the paddle and the powerup coins that can touch each other or a ball
+// The rounded ends of the paddle and the lowest pixel of each coin column are worked out once,
+//   so a contact check is a table lookup rather than a scan
+
+#ifndef PROFILES_H
+#define PROFILES_H
+#pragma once
+
+// Include the game core header for the board and paddle sizes
+#include "gamecore.h"
+
+// Declare and define constants
+const int MAXPADDLESIZE = 14; // Largest paddle size (number of 8 pixel blocks between the ends)
+const int PADDLEPROFILEROWS = 13; // Most rows of the board a paddle profile covers
+
+// What is touching the paddle, each saw the rounded paddle a row or pixel differently in the original checks
+const int PADDLEPROFILE_ACROSS = 0; // A ball moving sideways into the paddle
+const int PADDLEPROFILE_DOWN = 1; // A ball moving down onto the paddle
+const int PADDLEPROFILE_COIN = 2; // A coin falling onto the paddle
+const int PADDLEPROFILE_PUSH = 3; // The paddle moving into a ball
+const int NUM_PADDLEPROFILES = 4; // Number of paddle profiles
+
+// Structure for the pixels of the paddle something can touch, row by row
+struct PaddleProfile{
+	int top; // First row of the board the paddle can be touched on
+	int rows; // Number of rows the paddle can be touched on
+	int first[PADDLEPROFILEROWS]; // First pixel that touches the paddle on each row, counted from the paddle's left end
+	int last[PADDLEPROFILEROWS]; // Last pixel that touches the paddle on each row, counted from the paddle's left end
+};
+
+extern PaddleProfile paddleProfiles[NUM_PADDLEPROFILES][MAXPADDLESIZE+1]; // Profiles for each kind of contact and paddle size
+extern signed char coinBottoms[8][16]; // Lowest pixel of each column of each coin rotation (-1 = empty column)
+
+void BuildPaddleProfiles(); // Build the paddle profiles for every kind of contact and paddle size
+void BuildCoinBottoms(); // Find the lowest pixel of each column of each coin rotation from the coin map
+const PaddleProfile &GetPaddleProfile(int kind, int size); // Returns the paddle profile for a kind of contact and paddle size
+bool OnPaddle(const PaddleProfile &profile, int paddleLeft, int px, int py); // Does pixel px,py touch a paddle with its left end at paddleLeft
+int CoinBottom(int rotation, int x); // Returns the lowest pixel in column x of a coin rotation (-1 = empty column)
+
+#endif
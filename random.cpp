@@ -0,0 +1,37 @@
+// Random.cpp
+// The random numbers for a game, from small PCG generators kept in the game's state
+
+// Include the random header
+#include "random.h"
+
+void SeedRandomStream(RandomStream &stream, unsigned long long seed, unsigned long long sequence) // Start a stream from a seed
+{
+	stream.state = 0;
+	stream.increment = (sequence << 1) | 1; // The increment has to be odd
+	NextRandom(stream);
+	stream.state += seed;
+	NextRandom(stream); // Mix the seed in so close seeds start far apart
+}
+
+unsigned int NextRandom(RandomStream &stream) // Returns the next 32 bit number from a stream
+{
+	unsigned long long old = stream.state; // The state the number is made from
+	unsigned int shifted; // The high bits of the state folded down
+	unsigned int rotation; // The top 5 bits of the state pick a rotation
+
+	stream.state = old * 6364136223846793005ULL + stream.increment; // Step the 64 bit generator
+	shifted = (unsigned int)(((old >> 18) ^ old) >> 27);
+	rotation = (unsigned int)(old >> 59);
+	return (shifted >> rotation) | (shifted << ((32 - rotation) & 31));
+}
+
+int RandomBelow(RandomStream &stream, int range) // Returns the next number from a stream in 0 to range-1
+{
+	if(range <= 1)
+	{
+		NextRandom(stream); // Still draw, so the stream moves on the same way whatever the range
+		return 0;
+	}
+	// Scale into the range with a multiply rather than %, which is quicker and barely biased for small ranges
+	return (int)(((unsigned long long)NextRandom(stream) * (unsigned int)range) >> 32);
+}
@@ -0,0 +1,27 @@
+// Random.h
+// The random numbers for a game, from small PCG generators kept in the game's state
+// Each game has a stream for each kind of use, all worked out from the game's seed, so a seed and the
+//   player's input always play out the same game, and drawing from one stream never moves on another
+//   (a random explosion graphic can't change where the next ball appears)
+
+#ifndef RANDOM_H
+#define RANDOM_H
+#pragma once
+
+// The random streams of a game
+const int RANDOM_LEVEL = 0; // Building a level as it loads (which bricks hide powerup coins)
+const int RANDOM_PLAY = 1; // Anything else that changes how the game plays out (where an extra ball appears)
+const int RANDOM_COSMETIC = 2; // Things that are only seen or heard (explosion graphics, coin sounds)
+const int NUM_RANDOMSTREAMS = 3; // Number of random streams
+
+// Structure for a random stream (PCG32, 64 bits of state giving 32 bit numbers)
+struct RandomStream{
+	unsigned long long state; // Moves on with each number drawn
+	unsigned long long increment; // Picks the sequence, odd and different for each stream
+};
+
+void SeedRandomStream(RandomStream &stream, unsigned long long seed, unsigned long long sequence); // Start a stream from a seed, sequence picks one of many independent streams
+unsigned int NextRandom(RandomStream &stream); // Returns the next 32 bit number from a stream
+int RandomBelow(RandomStream &stream, int range); // Returns the next number from a stream in 0 to range-1
+
+#endif
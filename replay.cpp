@@ -0,0 +1,253 @@
+// Replay.cpp
+// Recording a game as the player's input, and playing it back as fast as it will go
+
+// Include the replay header
+#include "replay.h"
+
+// Include the save header for the byte and varint codec the replay files share with saves
+#include "savegame.h"
+
+// Include file input/output functions
+#include <stdio.h>
+
+void StartRecording(Replay &replay, unsigned long long seed) // Start a new game on the selected game from seed and start recording it
+{
+	replay.seed = seed;
+	replay.levelPackHash = levelPackHash;
+	replay.tickRate = GetTickRate();
+	replay.ballModel = GetBallModel();
+	replay.multiball = GetMultiball();
+	replay.ticks = 0;
+	replay.data.clear();
+	replay.lastTick = 0;
+	replay.lastDirection = 0; // StartGame stops the paddle
+	replay.lastRate = replay.tickRate;
+	replay.lastModel = replay.ballModel;
+
+	SeedGame(seed);
+	StartGame();
+}
+
+void RecordStep(Replay &replay, const TickInput &input) // Run one game update on the selected game and record it
+{
+	// Settings changed between game updates take effect from this one
+	if(GetTickRate() != replay.lastRate)
+	{
+		AddReplayRecord(replay, REPLAY_TICKRATE, GetTickRate());
+		replay.lastRate = GetTickRate();
+	}
+	if(GetBallModel() != replay.lastModel)
+	{
+		AddReplayRecord(replay, REPLAY_BALLMODEL, GetBallModel());
+		replay.lastModel = GetBallModel();
+	}
+
+	// Only changes of direction and presses of fire are recorded
+	if(input.paddleDirection != replay.lastDirection || input.fire)
+	{
+		AddReplayRecord(replay, REPLAY_INPUT, (input.paddleDirection + 1) | (input.fire ? 4 : 0));
+		replay.lastDirection = input.paddleDirection;
+	}
+
+	StepGame(input);
+	replay.ticks++;
+
+	if(replay.ticks % REPLAYCHECKTICKS == 0) // If a checksum is due...
+	{
+		AddReplayRecord(replay, REPLAY_CHECKSUM, (int)GameChecksum());
+	}
+}
+
+void FinishRecording(Replay &replay) // Record the checksum of the end of the game
+{
+	if(replay.ticks % REPLAYCHECKTICKS != 0) // If the last game update didn't already record one...
+	{
+		AddReplayRecord(replay, REPLAY_CHECKSUM, (int)GameChecksum());
+	}
+}
+
+void AddReplayRecord(Replay &replay, int kind, int value) // Add a record at the current game update
+{
+	PutVarint(replay.data, replay.ticks - replay.lastTick); // Game updates since the last record
+	replay.lastTick = replay.ticks;
+
+	if(kind == REPLAY_INPUT) // The input fits in the same byte as the kind
+	{
+		replay.data.push_back((unsigned char)(kind | (value << 3)));
+		return;
+	}
+	replay.data.push_back((unsigned char)kind);
+	if(kind == REPLAY_CHECKSUM) // Checksums are all 32 bits, so they aren't shortened
+	{
+		PutBytes(replay.data, (unsigned int)value, 4);
+	}
+	else
+	{
+		PutVarint(replay.data, (unsigned int)value);
+	}
+}
+
+bool SaveReplay(const Replay &replay, const char *filename) // Write a replay to a file
+{
+	FILE *file; // File to write the replay to
+	std::vector<unsigned char> header; // The header, written lowest byte first so the file is the same on any machine
+	bool written; // Was it all written
+
+	file = fopen(filename, "wb");
+	if(file == NULL)
+	{
+		return false;
+	}
+
+	PutBytes(header, REPLAYMAGIC, 4);
+	PutBytes(header, REPLAYVERSION, 2);
+	PutBytes(header, REPLAYHEADERSIZE, 2); // So a player can skip anything a newer version adds to the header
+	PutBytes(header, replay.seed, 8);
+	PutBytes(header, replay.levelPackHash, 4);
+	PutBytes(header, replay.ticks, 4);
+	PutBytes(header, replay.tickRate, 2);
+	PutBytes(header, replay.ballModel, 1);
+	PutBytes(header, replay.multiball, 1);
+	PutBytes(header, replay.data.size(), 4);
+	written = fwrite(&header[0], 1, header.size(), file) == header.size();
+	if(written && !replay.data.empty())
+	{
+		written = fwrite(&replay.data[0], 1, replay.data.size(), file) == replay.data.size();
+	}
+
+	return fclose(file) == 0 && written;
+}
+
+bool LoadReplay(Replay &replay, const char *filename) // Read a replay from a file
+{
+	FILE *file; // File to read the replay from
+	unsigned char header[REPLAYHEADERSIZE]; // The header as this version writes it
+	SaveReader reader = {header, sizeof(header), 0}; // Reads the header
+	int version; // Version of the format it was written in
+	int headerSize; // Bytes in its header
+	size_t size; // Bytes of records
+	long start, end; // Where the records start and the file ends
+	bool loaded; // Was it all read
+
+	file = fopen(filename, "rb");
+	if(file == NULL)
+	{
+		return false;
+	}
+	if(fread(header, 1, sizeof(header), file) != sizeof(header)) // If the file ended part way through the header...
+	{
+		fclose(file);
+		return false;
+	}
+
+	version = TakeBytes(reader, 4) == REPLAYMAGIC ? (int)TakeBytes(reader, 2) : 0;
+	if(version < 1 || version > REPLAYVERSION) // If it isn't a replay, or it's from a newer version whose records can't be known...
+	{
+		fclose(file);
+		return false;
+	}
+	headerSize = (int)TakeBytes(reader, 2);
+	replay.seed = TakeBytes(reader, 8);
+	replay.levelPackHash = (unsigned int)TakeBytes(reader, 4);
+	replay.ticks = (int)TakeBytes(reader, 4);
+	replay.tickRate = (int)TakeBytes(reader, 2);
+	replay.ballModel = (int)TakeBytes(reader, 1);
+	replay.multiball = TakeBytes(reader, 1) != 0;
+	size = (size_t)TakeBytes(reader, 4);
+	start = headerSize > REPLAYHEADERSIZE ? headerSize : REPLAYHEADERSIZE; // Skip any header added since
+	fseek(file, 0, SEEK_END);
+	end = ftell(file);
+	if(end < start || size > (size_t)(end - start)) // If there aren't as many bytes of records as it says (cut short or corrupt)...
+	{
+		fclose(file);
+		return false;
+	}
+	fseek(file, start, SEEK_SET);
+
+	replay.data.resize(size);
+	loaded = size == 0 || fread(&replay.data[0], 1, size, file) == size;
+	fclose(file);
+
+	replay.lastTick = replay.ticks;
+	return loaded;
+}
+
+bool PlayReplay(GameState &state, const Replay &replay, ReplayResult &result) // Play a replay on the given game
+{
+	TickInput input = {0, false}; // The player's input for the next game update
+	SaveReader records = {replay.data.empty() ? NULL : &replay.data[0], replay.data.size(), 0}; // Reads the records
+	int recordTick; // Game update the next record is for
+	int kind; // Kind of record
+	unsigned int checksum; // Checksum recorded
+	int n; // A setting's value
+
+	result.ticks = 0;
+	result.checks = 0;
+	result.firstMismatch = -1;
+	result.score = 0;
+	result.level = 0;
+	if(replay.levelPackHash != levelPackHash) // If the levels have changed since it was recorded...
+	{
+		return false; // It would play out differently
+	}
+
+	// Start the game the same way it was started when it was recorded
+	SetupGame(state, replay.seed);
+	SetMultiball(replay.multiball);
+	SetTickRate(replay.tickRate);
+	SetBallModel(replay.ballModel);
+	SeedGame(replay.seed);
+	StartGame();
+
+	recordTick = records.pos < records.size ? (int)TakeVarint(records) : -1;
+	while(true)
+	{
+		// Apply every record for this game update
+		while(recordTick == result.ticks && records.pos < records.size)
+		{
+			kind = records.data[records.pos] & 7;
+			if(kind == REPLAY_INPUT)
+			{
+				input.paddleDirection = ((records.data[records.pos] >> 3) & 3) - 1;
+				input.fire = (records.data[records.pos] & 32) != 0;
+				records.pos++;
+			}
+			else if(kind == REPLAY_CHECKSUM)
+			{
+				records.pos++;
+				checksum = (unsigned int)TakeBytes(records, 4);
+				result.checks++;
+				if(checksum != GameChecksum() && result.firstMismatch == -1) // If the game has played out differently...
+				{
+					result.firstMismatch = result.ticks;
+				}
+			}
+			else
+			{
+				records.pos++;
+				n = (int)TakeVarint(records);
+				if(kind == REPLAY_TICKRATE)
+				{
+					SetTickRate(n);
+				}
+				else if(kind == REPLAY_BALLMODEL)
+				{
+					SetBallModel(n);
+				}
+			}
+			recordTick = records.pos < records.size ? result.ticks + (int)TakeVarint(records) : -1;
+		}
+
+		if(result.ticks >= replay.ticks)
+		{
+			break;
+		}
+		StepGame(input);
+		input.fire = false; // A fire press only lasts one game update
+		result.ticks++;
+	}
+
+	result.score = GetScore();
+	result.level = GetLevel();
+	return true;
+}
@@ -0,0 +1,65 @@
+// Replay.h
+// Recording a game as the player's input, and playing it back as fast as it will go
+// A game plays out the same from the same seed and input, so a replay only needs the seed, the settings
+//   and a record each time the input or a setting changes, which is a few bytes a second
+// A checksum of the game is recorded every REPLAYCHECKTICKS game updates, so playing a replay back
+//   also checks the game still plays out exactly as it did when it was recorded
+
+#ifndef REPLAY_H
+#define REPLAY_H
+#pragma once
+
+// Include the game state header for the game being recorded or played
+#include "gamestate.h"
+
+// Include standard library
+#include <vector>
+
+// Declare and define constants
+const unsigned int REPLAYMAGIC = 0x50524B42; // "BKRP" at the start of a replay file
+const int REPLAYVERSION = 1; // Version of the replay format written, replays of a newer version aren't played as their records can't be known
+const int REPLAYHEADERSIZE = 32; // Bytes in the header written, newer versions can add more and it's skipped
+const int REPLAYCHECKTICKS = 20; // Game updates between the recorded checksums
+
+// The kinds of record, in the low 3 bits of a record's first byte
+const int REPLAY_INPUT = 0; // The paddle direction, and whether fire was pressed, from this game update on
+const int REPLAY_TICKRATE = 1; // The game update rate changed
+const int REPLAY_BALLMODEL = 2; // The ball model changed
+const int REPLAY_CHECKSUM = 3; // The checksum of the game after this many game updates
+
+// Structure for a replay
+struct Replay{
+	unsigned long long seed; // The seed the game was started from
+	unsigned int levelPackHash; // Hash of the levels file it was played on
+	int tickRate; // Game updates a second at the start
+	int ballModel; // Ball model at the start
+	bool multiball; // Was the multiball mode on
+	int ticks; // Number of game updates recorded
+	std::vector<unsigned char> data; // The records, each a count of game updates since the last one, the kind and its values
+
+	// While recording
+	int lastTick; // Game updates recorded when the last record was added
+	int lastDirection; // Paddle direction in the last input record
+	int lastRate; // Game update rate in the last record
+	int lastModel; // Ball model in the last record
+};
+
+// Structure for the result of playing a replay
+struct ReplayResult{
+	int ticks; // Number of game updates played
+	int checks; // Number of checksums compared
+	int firstMismatch; // Game updates played when a checksum first differed (-1 = none did)
+	int score; // Score at the end
+	int level; // Level at the end
+};
+
+void StartRecording(Replay &replay, unsigned long long seed); // Start a new game on the selected game from seed and start recording it
+void RecordStep(Replay &replay, const TickInput &input); // Run one game update on the selected game and record it
+void FinishRecording(Replay &replay); // Record the checksum of the end of the game
+bool SaveReplay(const Replay &replay, const char *filename); // Write a replay to a file
+bool LoadReplay(Replay &replay, const char *filename); // Read a replay from a file
+bool PlayReplay(GameState &state, const Replay &replay, ReplayResult &result); // Play a replay on the given game, returns false if it can't be played on these levels
+
+void AddReplayRecord(Replay &replay, int kind, int value); // Add a record at the current game update
+
+#endif
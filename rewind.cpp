@@ -0,0 +1,211 @@
+// Rewind.cpp
+// Keeping the last minute of a game in memory so it can be stepped back through
+
+// Include the rewind header
+#include "rewind.h"
+
+// Include the save game header for the frames and their numbers
+#include "savegame.h"
+
+// Include string functions
+#include <string.h>
+
+void ResetRewind(RewindBuffer &rewind) // Forget every frame, making room for them the first time
+{
+	if(rewind.store.empty())
+	{
+		rewind.store.resize(REWINDBYTES);
+		rewind.frames.resize(REWINDFRAMES);
+	}
+	rewind.first = 0;
+	rewind.next = 0;
+	rewind.writePos = 0;
+	rewind.used = 0;
+}
+
+void RecordRewind(RewindBuffer &rewind) // Keep a frame of the selected game if a 20 a second update has just finished
+{
+	long long keyframe = -1; // The frame this one differs from (-1 = it's a keyframe)
+	const RewindFrame *base; // That frame
+
+	if(game->tickPhase != 0) // Part way through a 20 a second update...
+	{
+		return;
+	}
+	if(rewind.store.empty())
+	{
+		ResetRewind(rewind);
+	}
+
+	SaveSnapshot(rewind.snapshot);
+	if(rewind.snapshot.size() > rewind.store.size() / 4) // If a handful of frames would fill the store (thousands of balls)...
+	{
+		ResetRewind(rewind); // There is no useful rewind
+		return;
+	}
+
+	if(rewind.next > rewind.first && rewind.next - rewind.frames[(rewind.next - 1) % REWINDFRAMES].keyframe < REWINDKEYFRAME)
+	{
+		keyframe = rewind.frames[(rewind.next - 1) % REWINDFRAMES].keyframe; // The same keyframe as the last frame
+	}
+	if(keyframe != -1)
+	{
+		base = &rewind.frames[keyframe % REWINDFRAMES];
+		EncodeDelta(&rewind.store[base->offset], base->size, rewind.snapshot, rewind.delta);
+		if(AddRewindFrame(rewind, rewind.delta, keyframe))
+		{
+			return;
+		}
+	}
+	AddRewindFrame(rewind, rewind.snapshot, rewind.next); // Start a new keyframe
+}
+
+bool StepBack(RewindBuffer &rewind, GameState &state) // Forget the newest frame and load the one before it into the given game
+{
+	if(rewind.next - rewind.first < 2) // If there is nothing before the newest frame...
+	{
+		return false;
+	}
+	rewind.next--;
+	rewind.used -= rewind.frames[rewind.next % REWINDFRAMES].size;
+	rewind.writePos = rewind.frames[rewind.next % REWINDFRAMES].offset; // Its bytes are free again
+	return LoadRewindFrame(rewind, state, rewind.next - 1);
+}
+
+bool LoadRewindFrame(RewindBuffer &rewind, GameState &state, long long frame) // Load a frame into the given game
+{
+	const RewindFrame *kept; // The frame
+	const RewindFrame *base; // Its keyframe
+
+	if(frame < rewind.first || frame >= rewind.next)
+	{
+		return false;
+	}
+	kept = &rewind.frames[frame % REWINDFRAMES];
+	if(kept->keyframe == frame) // If it's a keyframe it loads as it is
+	{
+		return LoadSnapshot(state, &rewind.store[kept->offset], kept->size);
+	}
+	base = &rewind.frames[kept->keyframe % REWINDFRAMES];
+	DecodeDelta(&rewind.store[base->offset], base->size, &rewind.store[kept->offset], kept->size, rewind.snapshot);
+	return LoadSnapshot(state, &rewind.snapshot[0], rewind.snapshot.size());
+}
+
+bool AddRewindFrame(RewindBuffer &rewind, const std::vector<unsigned char> &bytes, long long keyframe) // Write a frame, making room for it
+{
+	size_t size = bytes.size(); // Bytes of the frame
+	const RewindFrame *oldest; // The oldest frame kept
+	RewindFrame *frame; // The new frame
+
+	if(rewind.next - rewind.first == REWINDFRAMES) // If a minute is kept...
+	{
+		DropOldestFrame(rewind);
+	}
+
+	// The frames kept run from the oldest round to writePos, so room is made by forgetting the oldest
+	if(rewind.writePos + size > rewind.store.size()) // If it won't fit before the end of the store...
+	{
+		// The frames after writePos are the oldest, and are lost as the writing goes back round to the start
+		while(rewind.next > rewind.first && rewind.frames[rewind.first % REWINDFRAMES].offset >= rewind.writePos)
+		{
+			DropOldestFrame(rewind);
+		}
+		rewind.writePos = 0;
+	}
+	while(rewind.next > rewind.first)
+	{
+		oldest = &rewind.frames[rewind.first % REWINDFRAMES];
+		if(oldest->offset >= rewind.writePos + size || oldest->offset + oldest->size <= rewind.writePos) // If it's clear of the new frame...
+		{
+			break;
+		}
+		DropOldestFrame(rewind);
+	}
+	if(keyframe != rewind.next && keyframe < rewind.first) // If the frame it differs from has gone...
+	{
+		return false;
+	}
+
+	if(size > 0)
+	{
+		memcpy(&rewind.store[rewind.writePos], &bytes[0], size);
+	}
+	frame = &rewind.frames[rewind.next % REWINDFRAMES];
+	frame->offset = rewind.writePos;
+	frame->size = size;
+	frame->keyframe = keyframe;
+	rewind.writePos += size;
+	rewind.used += size;
+	rewind.next++;
+	return true;
+}
+
+void DropOldestFrame(RewindBuffer &rewind) // Forget the oldest frame, and any that differ from it
+{
+	do
+	{
+		rewind.used -= rewind.frames[rewind.first % REWINDFRAMES].size;
+		rewind.first++;
+	}
+	while(rewind.next > rewind.first && rewind.frames[rewind.first % REWINDFRAMES].keyframe < rewind.first);
+}
+
+// A delta is the size of the bytes it was written from, then runs of a count of bytes that are the same as
+//   the base followed by a count of bytes that differ and those bytes
+void EncodeDelta(const unsigned char *base, size_t baseSize, const std::vector<unsigned char> &now, std::vector<unsigned char> &delta)
+{
+	size_t pos = 0; // Next byte to compare
+	size_t same; // Bytes the same as the base
+	size_t start; // First byte that differs
+
+	delta.clear();
+	PutVarint(delta, (unsigned int)now.size());
+	while(pos < now.size())
+	{
+		start = pos;
+		while(pos < now.size() && pos < baseSize && now[pos] == base[pos])
+		{
+			pos++;
+		}
+		if(pos == now.size()) // The rest is the same
+		{
+			break;
+		}
+		same = pos - start;
+
+		// Take the bytes that differ up to the next few that are the same, so one changed byte in an int doesn't
+		// make three runs
+		start = pos;
+		while(pos < now.size() && !(pos + REWINDMATCH <= baseSize && pos + REWINDMATCH <= now.size() &&
+			memcmp(&now[pos], base + pos, REWINDMATCH) == 0))
+		{
+			pos++;
+		}
+		PutVarint(delta, (unsigned int)same);
+		PutVarint(delta, (unsigned int)(pos - start));
+		delta.insert(delta.end(), now.begin() + start, now.begin() + pos);
+	}
+}
+
+void DecodeDelta(const unsigned char *base, size_t baseSize, const unsigned char *delta, size_t deltaSize, std::vector<unsigned char> &now) // Put together the bytes a delta was written from
+{
+	SaveReader reader = {delta, deltaSize, 0}; // The delta
+	size_t size = TakeVarint(reader); // Bytes it was written from
+	size_t pos = 0; // Next byte to fill in
+	size_t length; // Bytes that differ in the run
+
+	now.assign(base, base + (size < baseSize ? size : baseSize));
+	now.resize(size);
+	while(reader.pos < reader.size)
+	{
+		pos += TakeVarint(reader);
+		length = TakeVarint(reader);
+		if(pos + length > size || length > reader.size - reader.pos) // A delta that doesn't fit is cut short
+		{
+			break;
+		}
+		memcpy(&now[pos], reader.data + reader.pos, length);
+		reader.pos += length;
+		pos += length;
+	}
+}
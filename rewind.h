@@ -0,0 +1,54 @@
+// Rewind.h
+// Keeping the last minute of a game in memory so it can be stepped back through
+// A frame is saved after each 20 a second update, as a full save (a keyframe) once a second and otherwise as
+//   just the bytes that differ from the save of that keyframe, as little changes in a second (a few bricks,
+//   the balls and the paddle), so any frame is loaded from its keyframe and one delta whatever its age
+// The frames are written round and round a store of a fixed size, the oldest giving way to the newest
+
+#ifndef REWIND_H
+#define REWIND_H
+#pragma once
+
+// Include the game state header for the game being rewound
+#include "gamestate.h"
+
+// Include standard library
+#include <vector>
+
+// Declare and define constants
+const int REWINDSECONDS = 60; // Seconds of play kept
+const int REWINDFRAMES = REWINDSECONDS*BASETICKRATE; // Frames kept, one for each 20 a second update
+const int REWINDKEYFRAME = BASETICKRATE; // Frames from one keyframe to the next
+const int REWINDBYTES = 1 << 20; // Bytes the frames are kept in
+const int REWINDMATCH = 4; // Bytes that have to be the same for a delta to skip over them
+
+// Structure for a frame kept
+struct RewindFrame{
+	size_t offset; // Where its bytes start in the store
+	size_t size; // Number of bytes
+	long long keyframe; // The frame it differs from (its own number if it's a keyframe)
+};
+
+// Structure for the frames of a game
+struct RewindBuffer{
+	std::vector<unsigned char> store; // The bytes of the frames, written round and round
+	std::vector<RewindFrame> frames; // The frames, frame number n kept at n % REWINDFRAMES
+	long long first; // Number of the oldest frame kept
+	long long next; // Number the next frame gets (first == next when there are none)
+	size_t writePos; // Where the next frame's bytes go in the store
+	size_t used; // Bytes of the store used by the frames kept
+	std::vector<unsigned char> snapshot; // The save being recorded or loaded
+	std::vector<unsigned char> delta; // The delta being written
+};
+
+void ResetRewind(RewindBuffer &rewind); // Forget every frame, making room for them the first time
+void RecordRewind(RewindBuffer &rewind); // Keep a frame of the selected game if a 20 a second update has just finished
+bool StepBack(RewindBuffer &rewind, GameState &state); // Forget the newest frame and load the one before it into the given game, returns false if there isn't one
+bool LoadRewindFrame(RewindBuffer &rewind, GameState &state, long long frame); // Load a frame into the given game, returns false if it isn't kept
+
+bool AddRewindFrame(RewindBuffer &rewind, const std::vector<unsigned char> &bytes, long long keyframe); // Write a frame, making room for it, returns false if its keyframe had to make room
+void DropOldestFrame(RewindBuffer &rewind); // Forget the oldest frame, and any that differ from it
+void EncodeDelta(const unsigned char *base, size_t baseSize, const std::vector<unsigned char> &now, std::vector<unsigned char> &delta); // Write the bytes of now that differ from base
+void DecodeDelta(const unsigned char *base, size_t baseSize, const unsigned char *delta, size_t deltaSize, std::vector<unsigned char> &now); // Put together the bytes a delta was written from
+
+#endif
@@ -0,0 +1,678 @@
+// SaveGame.cpp
+// Saving a game in progress and picking it up again exactly where it was
+
+// Include the save game header
+#include "savegame.h"
+
+// Include file input/output functions
+#include <stdio.h>
+
+// Include string functions
+#include <string.h>
+
+// Declare functions
+void PutBall(std::vector<unsigned char> &data, const Ball &ball); // Add the fields of a ball
+void TakeBall(SaveReader &reader, Ball &ball); // Read the fields of a ball
+void PutCoin(std::vector<unsigned char> &data, const Coin &coin); // Add the fields of a coin
+void TakeCoin(SaveReader &reader, Coin &coin); // Read the fields of a coin
+void PutExplosion(std::vector<unsigned char> &data, const Explosion &explosion); // Add the fields of an explosion
+void TakeExplosion(SaveReader &reader, Explosion &explosion); // Read the fields of an explosion
+void PutBullet(std::vector<unsigned char> &data, const Bullet &bullet); // Add the fields of a bullet
+void TakeBullet(SaveReader &reader, Bullet &bullet); // Read the fields of a bullet
+bool LoadChunk(unsigned int tag, SaveReader &reader); // Load one chunk into the selected game, returns false if it can't be used
+void PutRuns(std::vector<unsigned char> &data, const std::vector<unsigned int> &runs); // Add runs, each a first value and a length
+bool TakeRuns(SaveReader &reader, std::vector<unsigned int> &runs, int total); // Read runs written by PutRuns, returns false if their lengths don't add up to total
+
+// Each pool is saved as its capacity, the number in use and the bytes of each object, then the generation of
+//   every slot, the slots of the objects in use, the free slots and the objects themselves
+// The generations are saved as runs of slots with the same generation, and the free slots as runs counting down,
+//   as a pool that has been little used is mostly one long run of each (and a multiball pool has room for 10000)
+// A loader skips the end of each object if a newer version has added fields to it
+template<typename T>
+void PutPool(std::vector<unsigned char> &data, const Pool<T> &pool, void (*put)(std::vector<unsigned char> &, const T &))
+{
+	const std::vector<int> &freeSlots = pool.FreeSlots(); // Slots not in use
+	std::vector<unsigned int> runs; // Each run as its first value and its length
+	size_t objectPos; // Where the bytes of each object goes
+	size_t start; // Where the first object starts
+	int n; // Counter
+
+	PutVarint(data, pool.Capacity());
+	PutVarint(data, pool.Count());
+	objectPos = data.size();
+	PutBytes(data, 0, 2); // Filled in after the first object
+
+	for(n = 0; n < pool.Capacity(); n++)
+	{
+		if(n > 0 && pool.SlotGeneration(n) == runs[runs.size() - 2])
+		{
+			runs.back()++;
+		}
+		else
+		{
+			runs.push_back(pool.SlotGeneration(n));
+			runs.push_back(1);
+		}
+	}
+	PutRuns(data, runs);
+
+	for(n = 0; n < pool.Count(); n++)
+	{
+		PutVarint(data, pool.Handle(n).slot);
+	}
+
+	runs.clear();
+	for(n = 0; n < (int)freeSlots.size(); n++)
+	{
+		if(n > 0 && freeSlots[n] == freeSlots[n-1] - 1)
+		{
+			runs.back()++;
+		}
+		else
+		{
+			runs.push_back(freeSlots[n]);
+			runs.push_back(1);
+		}
+	}
+	PutRuns(data, runs);
+
+	start = data.size();
+	for(n = 0; n < pool.Count(); n++)
+	{
+		put(data, pool[n]);
+		if(n == 0)
+		{
+			data[objectPos] = (unsigned char)(data.size() - start);
+			data[objectPos + 1] = (unsigned char)((data.size() - start) >> 8);
+		}
+	}
+}
+
+template<typename T>
+bool TakePool(SaveReader &reader, Pool<T> &pool, int maxCapacity, void (*take)(SaveReader &, T &))
+{
+	std::vector<unsigned int> runs; // Each run as its first value and its length
+	std::vector<unsigned int> generations; // The generation of each slot
+	std::vector<int> slots; // The slots of the objects in use
+	std::vector<int> freeSlots; // The free slots
+	SaveReader object; // The bytes of one object
+	int capacity = (int)TakeVarint(reader); // Room saved
+	int count = (int)TakeVarint(reader); // Objects saved
+	size_t objectSize = (size_t)TakeBytes(reader, 2); // Bytes of each object
+	size_t n, m; // Counters
+
+	// Nothing is made room for until the numbers are known to be ones the game could have saved, so a damaged
+	// save can't ask for more memory than there is
+	if(capacity < 0 || capacity > maxCapacity || count < 0 || count > capacity)
+	{
+		return false;
+	}
+	if(!TakeRuns(reader, runs, capacity))
+	{
+		return false;
+	}
+	for(n = 0; n < runs.size(); n += 2)
+	{
+		generations.insert(generations.end(), runs[n+1], runs[n]);
+	}
+	if(reader.size - reader.pos < (size_t)count) // Every slot takes at least a byte
+	{
+		return false;
+	}
+	for(m = 0; m < (size_t)count; m++)
+	{
+		slots.push_back((int)TakeVarint(reader));
+	}
+	if(!TakeRuns(reader, runs, capacity - count))
+	{
+		return false;
+	}
+	for(n = 0; n < runs.size(); n += 2)
+	{
+		for(m = 0; m < runs[n+1]; m++)
+		{
+			freeSlots.push_back((int)(runs[n] - m));
+		}
+	}
+	if(reader.size - reader.pos < count * objectSize) // If the objects can't all be there...
+	{
+		return false;
+	}
+
+	if(pool.Capacity() != capacity) // If the save was made with more or less room...
+	{
+		pool.Resize(capacity);
+	}
+	if(!pool.Restore(slots, generations, freeSlots))
+	{
+		return false;
+	}
+	for(m = 0; m < (size_t)count; m++)
+	{
+		object.data = reader.data + reader.pos;
+		object.size = objectSize;
+		object.pos = 0;
+		take(object, pool[m]);
+		reader.pos += objectSize;
+	}
+	return true;
+}
+
+void SaveSnapshot(std::vector<unsigned char> &data) // Save the selected game into data, replacing what was there
+{
+	size_t chunk; // Where the length of the chunk being written goes
+	int n, m; // Counters
+
+	data.clear();
+	PutBytes(data, SAVEMAGIC, 4);
+	PutBytes(data, SAVEVERSION, 2);
+	PutBytes(data, SAVEHEADERSIZE, 2);
+	PutBytes(data, levelPackHash, 4); // The levels the game is being played on
+
+	chunk = StartChunk(data, SAVE_GAME);
+	PutBytes(data, game->level, 4);
+	PutBytes(data, game->score, 4);
+	PutBytes(data, game->scoreMultiplier, 4);
+	PutBytes(data, game->livesRemaining, 4);
+	PutBytes(data, game->numBricks, 4);
+	PutBytes(data, game->gamePaused, 4);
+	PutBytes(data, game->gameLost, 1);
+	PutBytes(data, game->levelComplete, 1);
+	PutBytes(data, game->gameTick, 4);
+	PutBytes(data, game->tickRate, 4);
+	PutBytes(data, game->tickPhase, 4);
+	PutBytes(data, game->ballModel, 4);
+	PutBytes(data, game->multiball, 1);
+	PutBytes(data, game->broadPhase, 1);
+	EndChunk(data, chunk);
+
+	chunk = StartChunk(data, SAVE_PADDLE);
+	PutBytes(data, game->paddleSize, 4);
+	PutBytes(data, game->paddlePos, 4);
+	PutBytes(data, game->lastPaddlePos, 4);
+	PutBytes(data, game->paddleSpeed, 4);
+	PutBytes(data, game->paddleDirection, 4);
+	PutBytes(data, game->magnetic, 4);
+	PutBytes(data, game->laser, 4);
+	PutBytes(data, game->laserPierce, 4);
+	EndChunk(data, chunk);
+
+	chunk = StartChunk(data, SAVE_MESSAGES);
+	for(n = 0; n < 3; n++)
+	{
+		PutBytes(data, game->messages[n], 4);
+	}
+	PutBytes(data, game->messageTimer, 4);
+	EndChunk(data, chunk);
+
+	chunk = StartChunk(data, SAVE_RANDOM);
+	PutBytes(data, game->seed, 8);
+	PutBytes(data, NUM_RANDOMSTREAMS, 1);
+	for(n = 0; n < NUM_RANDOMSTREAMS; n++)
+	{
+		PutBytes(data, game->randoms[n].state, 8);
+		PutBytes(data, game->randoms[n].increment, 8);
+	}
+	EndChunk(data, chunk);
+
+	// The bit boards are saved as they are, so loading doesn't have to place the bricks one at a time
+	chunk = StartChunk(data, SAVE_BRICKS);
+	PutBytes(data, BGAMEWIDTH, 1);
+	PutBytes(data, BGAMEHEIGHT, 1);
+	for(n = 0; n < BGAMEHEIGHT+1; n++)
+	{
+		PutBytes(data, game->brickGrid.rows[n], 8);
+		PutBytes(data, game->brickGrid.grey[n], 8);
+		PutBytes(data, game->brickGrid.explosive[n], 8);
+	}
+	for(n = 0; n < BGAMEWIDTH; n++)
+	{
+		PutBytes(data, game->brickGrid.columns[n], 4);
+	}
+	for(n = 0; n < BGAMEHEIGHT+1; n++)
+	{
+		data.insert(data.end(), game->brickGrid.style[n], game->brickGrid.style[n] + BGAMEWIDTH);
+		data.insert(data.end(), game->brickGrid.colour[n], game->brickGrid.colour[n] + BGAMEWIDTH);
+		data.insert(data.end(), game->brickGrid.powerup[n], game->brickGrid.powerup[n] + BGAMEWIDTH);
+	}
+	EndChunk(data, chunk);
+
+	chunk = StartChunk(data, SAVE_BALLS);
+	PutPool(data, game->balls, PutBall);
+	EndChunk(data, chunk);
+	chunk = StartChunk(data, SAVE_COINS);
+	PutPool(data, game->coins, PutCoin);
+	EndChunk(data, chunk);
+	chunk = StartChunk(data, SAVE_EXPLOSIONS);
+	PutPool(data, game->explosions, PutExplosion);
+	EndChunk(data, chunk);
+	chunk = StartChunk(data, SAVE_BULLETS);
+	PutPool(data, game->bullets, PutBullet);
+	EndChunk(data, chunk);
+
+	// Only the slots with events are saved, each as the wheel (0 near, 1 far), the slot and its events in order
+	chunk = StartChunk(data, SAVE_TIMERS);
+	for(n = 0; n < TIMERSLOTS*2; n++)
+	{
+		const std::vector<TimerEvent> &slot = n < TIMERSLOTS ? game->timerWheel.nearSlots[n] : game->timerWheel.farSlots[n - TIMERSLOTS]; // Slot being saved
+		if(slot.empty())
+		{
+			continue;
+		}
+		PutBytes(data, n / TIMERSLOTS, 1);
+		PutBytes(data, n % TIMERSLOTS, 2);
+		PutBytes(data, slot.size(), 4);
+		for(m = 0; m < (int)slot.size(); m++)
+		{
+			PutBytes(data, slot[m].due, 4);
+			PutBytes(data, slot[m].kind, 1);
+			PutBytes(data, slot[m].owner.slot, 4);
+			PutBytes(data, slot[m].owner.generation, 4);
+		}
+	}
+	EndChunk(data, chunk);
+}
+
+bool LoadSnapshot(GameState &state, const unsigned char *data, size_t size) // Load a save into the given game
+{
+	SaveReader reader = {data, size, 0}; // The whole save
+	SaveReader chunk; // The chunk being loaded
+	unsigned int tag; // Tag of the chunk being loaded
+	size_t length; // Bytes in the chunk being loaded
+	int headerSize; // Bytes in the header
+	int chunks = 0; // Chunks loaded
+
+	if(TakeBytes(reader, 4) != SAVEMAGIC || TakeBytes(reader, 2) < 1) // If it isn't a save...
+	{
+		return false;
+	}
+	headerSize = (int)TakeBytes(reader, 2);
+	if(TakeBytes(reader, 4) != levelPackHash || headerSize < SAVEHEADERSIZE || (size_t)headerSize > size) // If it was saved on other levels...
+	{
+		return false; // The levels still to come would be different
+	}
+	reader.pos = headerSize; // Skip any header added since
+
+	GameSelection select(state); // Selected while it loads, whether or not it loads
+	ResetTimers(); // The wheel only holds the events saved
+	game->gameEvents.clear();
+	while(size - reader.pos >= 8)
+	{
+		tag = (unsigned int)TakeBytes(reader, 4);
+		length = (size_t)TakeBytes(reader, 4);
+		if(length > size - reader.pos) // If the chunk runs past the end...
+		{
+			return false;
+		}
+		chunk.data = data + reader.pos;
+		chunk.size = length;
+		chunk.pos = 0;
+		if(!LoadChunk(tag, chunk))
+		{
+			return false;
+		}
+		if(tag == SAVE_GAME || tag == SAVE_PADDLE || tag == SAVE_MESSAGES || tag == SAVE_RANDOM || tag == SAVE_BRICKS ||
+			tag == SAVE_BALLS || tag == SAVE_COINS || tag == SAVE_EXPLOSIONS || tag == SAVE_BULLETS || tag == SAVE_TIMERS)
+		{
+			chunks++;
+		}
+		reader.pos += length; // Skip anything in the chunk that wasn't read
+	}
+	return chunks == 10; // Every part of the game has to have been loaded
+}
+
+bool LoadChunk(unsigned int tag, SaveReader &reader) // Load one chunk into the selected game, returns false if it can't be used
+{
+	TimerEvent event; // Timer event being loaded
+	int wheel, slot, count; // Slot of the timer wheel being loaded and its number of events
+	int n; // Counter
+
+	switch(tag)
+	{
+	case SAVE_GAME:
+		game->level = (int)TakeBytes(reader, 4);
+		game->score = (int)TakeBytes(reader, 4);
+		game->scoreMultiplier = (int)TakeBytes(reader, 4);
+		game->livesRemaining = (int)TakeBytes(reader, 4);
+		game->numBricks = (int)TakeBytes(reader, 4);
+		game->gamePaused = (int)TakeBytes(reader, 4);
+		game->gameLost = TakeBytes(reader, 1) != 0;
+		game->levelComplete = TakeBytes(reader, 1) != 0;
+		game->gameTick = (int)TakeBytes(reader, 4);
+		game->tickRate = (int)TakeBytes(reader, 4);
+		game->tickPhase = (int)TakeBytes(reader, 4);
+		game->ballModel = (int)TakeBytes(reader, 4);
+		game->multiball = TakeBytes(reader, 1) != 0;
+		game->broadPhase = TakeBytes(reader, 1) != 0;
+		return game->tickRate >= BASETICKRATE && game->tickRate <= MAXTICKRATE && game->tickRate % BASETICKRATE == 0;
+	case SAVE_PADDLE:
+		game->paddleSize = (int)TakeBytes(reader, 4);
+		game->paddlePos = (int)TakeBytes(reader, 4);
+		game->lastPaddlePos = (int)TakeBytes(reader, 4);
+		game->paddleSpeed = (int)TakeBytes(reader, 4);
+		game->paddleDirection = (int)TakeBytes(reader, 4);
+		game->magnetic = (int)TakeBytes(reader, 4);
+		game->laser = (int)TakeBytes(reader, 4);
+		game->laserPierce = (int)TakeBytes(reader, 4);
+		return true;
+	case SAVE_MESSAGES:
+		for(n = 0; n < 3; n++)
+		{
+			game->messages[n] = (int)TakeBytes(reader, 4);
+		}
+		game->messageTimer = (int)TakeBytes(reader, 4);
+		return true;
+	case SAVE_RANDOM:
+		game->seed = TakeBytes(reader, 8);
+		if((int)TakeBytes(reader, 1) < NUM_RANDOMSTREAMS) // A stream added since couldn't be worked out from the others
+		{
+			return false;
+		}
+		for(n = 0; n < NUM_RANDOMSTREAMS; n++)
+		{
+			game->randoms[n].state = TakeBytes(reader, 8);
+			game->randoms[n].increment = TakeBytes(reader, 8);
+		}
+		return true;
+	case SAVE_BRICKS:
+		if(TakeBytes(reader, 1) != BGAMEWIDTH || TakeBytes(reader, 1) != BGAMEHEIGHT ||
+			reader.size < (BGAMEHEIGHT+1) * (24 + 3*BGAMEWIDTH) + BGAMEWIDTH*4 + 2) // If it's not the same board...
+		{
+			return false;
+		}
+		for(n = 0; n < BGAMEHEIGHT+1; n++)
+		{
+			game->brickGrid.rows[n] = TakeBytes(reader, 8);
+			game->brickGrid.grey[n] = TakeBytes(reader, 8);
+			game->brickGrid.explosive[n] = TakeBytes(reader, 8);
+		}
+		for(n = 0; n < BGAMEWIDTH; n++)
+		{
+			game->brickGrid.columns[n] = (unsigned int)TakeBytes(reader, 4);
+		}
+		for(n = 0; n < BGAMEHEIGHT+1; n++)
+		{
+			memcpy(game->brickGrid.style[n], reader.data + reader.pos, BGAMEWIDTH);
+			memcpy(game->brickGrid.colour[n], reader.data + reader.pos + BGAMEWIDTH, BGAMEWIDTH);
+			memcpy(game->brickGrid.powerup[n], reader.data + reader.pos + BGAMEWIDTH*2, BGAMEWIDTH);
+			reader.pos += BGAMEWIDTH*3;
+		}
+		return true;
+	case SAVE_BALLS:
+		return TakePool(reader, game->balls, MULTIBALLMAXBALLS, TakeBall);
+	case SAVE_COINS:
+		return TakePool(reader, game->coins, MAXCOINS, TakeCoin);
+	case SAVE_EXPLOSIONS:
+		return TakePool(reader, game->explosions, MAXEXPLOSIONS, TakeExplosion);
+	case SAVE_BULLETS:
+		return TakePool(reader, game->bullets, MULTIBALLMAXBULLETS, TakeBullet);
+	case SAVE_TIMERS:
+		while(reader.size - reader.pos >= 7)
+		{
+			wheel = (int)TakeBytes(reader, 1);
+			slot = (int)TakeBytes(reader, 2);
+			count = (int)TakeBytes(reader, 4);
+			if(wheel > 1 || slot >= TIMERSLOTS || count < 0 || (size_t)count * 13 > reader.size - reader.pos)
+			{
+				return false;
+			}
+			std::vector<TimerEvent> &events = wheel == 0 ? game->timerWheel.nearSlots[slot] : game->timerWheel.farSlots[slot]; // Slot being loaded
+			for(n = 0; n < count; n++)
+			{
+				event.due = (int)TakeBytes(reader, 4);
+				event.kind = (int)TakeBytes(reader, 1);
+				event.owner.slot = (int)TakeBytes(reader, 4);
+				event.owner.generation = (unsigned int)TakeBytes(reader, 4);
+				events.push_back(event);
+			}
+		}
+		return true;
+	}
+	return true; // A chunk added since is skipped
+}
+
+bool SaveGameFile(const char *filename) // Save the selected game to a file
+{
+	std::vector<unsigned char> data; // The save
+	FILE *file; // File to write the save to
+	bool saved; // Was it all written
+
+	SaveSnapshot(data);
+	file = fopen(filename, "wb");
+	if(file == NULL)
+	{
+		return false;
+	}
+	saved = fwrite(&data[0], 1, data.size(), file) == data.size();
+	return fclose(file) == 0 && saved;
+}
+
+bool LoadGameFile(GameState &state, const char *filename) // Load a game saved to a file into the given game
+{
+	std::vector<unsigned char> data; // The save
+	FILE *file; // File to read the save from
+	long size; // Bytes in the file
+
+	file = fopen(filename, "rb");
+	if(file == NULL)
+	{
+		return false;
+	}
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	if(size <= 0)
+	{
+		fclose(file);
+		return false;
+	}
+	data.resize(size);
+	if(fread(&data[0], 1, size, file) != (size_t)size)
+	{
+		fclose(file);
+		return false;
+	}
+	fclose(file);
+	return LoadSnapshot(state, &data[0], data.size());
+}
+
+void PutBytes(std::vector<unsigned char> &data, unsigned long long value, int bytes) // Add a number lowest byte first
+{
+	int n; // Counter
+
+	for(n = 0; n < bytes; n++)
+	{
+		data.push_back((unsigned char)(value >> (n*8)));
+	}
+}
+
+unsigned long long TakeBytes(SaveReader &reader, int bytes) // Read a number written by PutBytes (0 past the end)
+{
+	unsigned long long value = 0; // The number so far
+	int n; // Counter
+
+	if(reader.size - reader.pos < (size_t)bytes) // A field an older version didn't write reads as 0
+	{
+		reader.pos = reader.size;
+		return 0;
+	}
+	for(n = 0; n < bytes; n++)
+	{
+		value |= (unsigned long long)reader.data[reader.pos++] << (n*8);
+	}
+	return value;
+}
+
+size_t StartChunk(std::vector<unsigned char> &data, unsigned int tag) // Start a chunk, returns where its length goes
+{
+	PutBytes(data, tag, 4);
+	PutBytes(data, 0, 4); // Filled in by EndChunk
+	return data.size() - 4;
+}
+
+void EndChunk(std::vector<unsigned char> &data, size_t lengthPos) // Fill in the length of the chunk just written
+{
+	size_t length = data.size() - lengthPos - 4; // Bytes after the length
+	int n; // Counter
+
+	for(n = 0; n < 4; n++)
+	{
+		data[lengthPos + n] = (unsigned char)(length >> (n*8));
+	}
+}
+
+void PutBall(std::vector<unsigned char> &data, const Ball &ball) // Add the fields of a ball
+{
+	PutBytes(data, ball.size, 4);
+	PutBytes(data, ball.x, 4);
+	PutBytes(data, ball.y, 4);
+	PutBytes(data, ball.speedX, 4);
+	PutBytes(data, ball.speedY, 4);
+	PutBytes(data, ball.subX, 4);
+	PutBytes(data, ball.subY, 4);
+	PutBytes(data, ball.speedMod, 4);
+	PutBytes(data, ball.stuck, 1);
+	PutBytes(data, ball.fire, 4);
+	PutBytes(data, ball.explosive, 4);
+	PutBytes(data, ball.noRebound, 4);
+	PutBytes(data, ball.bricks, 4);
+	PutBytes(data, ball.greyBricks, 4);
+	PutBytes(data, ball.lastX, 4);
+	PutBytes(data, ball.lastY, 4);
+}
+
+void TakeBall(SaveReader &reader, Ball &ball) // Read the fields of a ball
+{
+	ball.size = (int)TakeBytes(reader, 4);
+	ball.x = (int)TakeBytes(reader, 4);
+	ball.y = (int)TakeBytes(reader, 4);
+	ball.speedX = (int)TakeBytes(reader, 4);
+	ball.speedY = (int)TakeBytes(reader, 4);
+	ball.subX = (int)TakeBytes(reader, 4);
+	ball.subY = (int)TakeBytes(reader, 4);
+	ball.speedMod = (int)TakeBytes(reader, 4);
+	ball.stuck = TakeBytes(reader, 1) != 0;
+	ball.fire = (int)TakeBytes(reader, 4);
+	ball.explosive = (int)TakeBytes(reader, 4);
+	ball.noRebound = (int)TakeBytes(reader, 4);
+	ball.bricks = (int)TakeBytes(reader, 4);
+	ball.greyBricks = (int)TakeBytes(reader, 4);
+	ball.lastX = (int)TakeBytes(reader, 4);
+	ball.lastY = (int)TakeBytes(reader, 4);
+}
+
+void PutCoin(std::vector<unsigned char> &data, const Coin &coin) // Add the fields of a coin
+{
+	PutBytes(data, coin.x, 4);
+	PutBytes(data, coin.y, 4);
+	PutBytes(data, coin.rotationPos, 4);
+	PutBytes(data, coin.powerup, 4);
+	PutBytes(data, coin.lastX, 4);
+	PutBytes(data, coin.lastY, 4);
+}
+
+void TakeCoin(SaveReader &reader, Coin &coin) // Read the fields of a coin
+{
+	coin.x = (int)TakeBytes(reader, 4);
+	coin.y = (int)TakeBytes(reader, 4);
+	coin.rotationPos = (int)TakeBytes(reader, 4);
+	coin.powerup = (int)TakeBytes(reader, 4);
+	coin.lastX = (int)TakeBytes(reader, 4);
+	coin.lastY = (int)TakeBytes(reader, 4);
+}
+
+void PutExplosion(std::vector<unsigned char> &data, const Explosion &explosion) // Add the fields of an explosion
+{
+	PutBytes(data, explosion.x, 4);
+	PutBytes(data, explosion.y, 4);
+	PutBytes(data, explosion.size, 4);
+}
+
+void TakeExplosion(SaveReader &reader, Explosion &explosion) // Read the fields of an explosion
+{
+	explosion.x = (int)TakeBytes(reader, 4);
+	explosion.y = (int)TakeBytes(reader, 4);
+	explosion.size = (int)TakeBytes(reader, 4);
+}
+
+void PutBullet(std::vector<unsigned char> &data, const Bullet &bullet) // Add the fields of a bullet
+{
+	PutBytes(data, bullet.x, 4);
+	PutBytes(data, bullet.y, 4);
+	PutBytes(data, bullet.remove, 1);
+	PutBytes(data, bullet.pierce, 4);
+	PutBytes(data, bullet.lastX, 4);
+	PutBytes(data, bullet.lastY, 4);
+}
+
+void TakeBullet(SaveReader &reader, Bullet &bullet) // Read the fields of a bullet
+{
+	bullet.x = (int)TakeBytes(reader, 4);
+	bullet.y = (int)TakeBytes(reader, 4);
+	bullet.remove = TakeBytes(reader, 1) != 0;
+	bullet.pierce = (int)TakeBytes(reader, 4);
+	bullet.lastX = (int)TakeBytes(reader, 4);
+	bullet.lastY = (int)TakeBytes(reader, 4);
+}
+
+void PutVarint(std::vector<unsigned char> &data, unsigned int value) // Add a number 7 bits a byte, small numbers take one byte
+{
+	while(value >= 128) // The top bit of each byte says more bytes follow
+	{
+		data.push_back((unsigned char)(value | 128));
+		value >>= 7;
+	}
+	data.push_back((unsigned char)value);
+}
+
+unsigned int TakeVarint(SaveReader &reader) // Read a number written by PutVarint (0 past the end)
+{
+	unsigned int value = 0; // The number so far
+	int shift = 0; // Bits read so far
+
+	while(reader.pos < reader.size && shift < 32)
+	{
+		value |= (unsigned int)(reader.data[reader.pos] & 127) << shift;
+		shift += 7;
+		if(!(reader.data[reader.pos++] & 128)) // If it was the last byte...
+		{
+			break;
+		}
+	}
+	return value;
+}
+
+void PutRuns(std::vector<unsigned char> &data, const std::vector<unsigned int> &runs) // Add runs, each a first value and a length
+{
+	size_t n; // Counter
+
+	PutVarint(data, (unsigned int)(runs.size() / 2));
+	for(n = 0; n < runs.size(); n++)
+	{
+		PutVarint(data, runs[n]);
+	}
+}
+
+bool TakeRuns(SaveReader &reader, std::vector<unsigned int> &runs, int total) // Read runs written by PutRuns, returns false if their lengths don't add up to total
+{
+	unsigned int numRuns = TakeVarint(reader); // Number of runs
+	unsigned int n; // Counter
+	int length = 0; // Total length so far
+
+	runs.clear();
+	if(numRuns > (unsigned int)total || numRuns > (reader.size - reader.pos) / 2) // Every run is at least one long and two bytes
+	{
+		return false;
+	}
+	for(n = 0; n < numRuns; n++)
+	{
+		runs.push_back(TakeVarint(reader));
+		runs.push_back(TakeVarint(reader));
+		if(runs.back() == 0 || runs.back() > (unsigned int)(total - length))
+		{
+			return false;
+		}
+		length += runs.back();
+	}
+	return length == total;
+}
@@ -0,0 +1,57 @@
+// SaveGame.h
+// Saving a game in progress and picking it up again exactly where it was
+// A save is a short header then a list of chunks, each a tag, its length and its fields written lowest byte first
+// A loader skips chunks it doesn't know and the end of any chunk a newer version has added fields to, and a
+//   field an older save doesn't have is left at its starting value, so saves move between versions either way
+// The pools are saved with their slots and the timer wheel with its events in their slots, so a loaded game
+//   carries on exactly as the saved one would have
+// The replay files are written with the same byte and varint codec, so the two formats read numbers alike
+
+#ifndef SAVEGAME_H
+#define SAVEGAME_H
+#pragma once
+
+// Include the game state header for the game being saved or loaded
+#include "gamestate.h"
+
+// Include standard library
+#include <vector>
+
+// Declare and define constants
+const unsigned int SAVEMAGIC = 0x56534B42; // "BKSV" at the start of a save
+const int SAVEVERSION = 1; // Version of the save format written
+const int SAVEHEADERSIZE = 12; // Bytes in the header written, newer versions can add more and older loaders skip them
+
+// The chunks of a save, tagged with four letters
+const unsigned int SAVE_GAME = 0x454D4147; // "GAME" progress and settings
+const unsigned int SAVE_PADDLE = 0x4C444150; // "PADL" the paddle and its powerups
+const unsigned int SAVE_MESSAGES = 0x4753454D; // "MESG" the message queue
+const unsigned int SAVE_RANDOM = 0x444E4152; // "RAND" the random streams
+const unsigned int SAVE_BRICKS = 0x4B495242; // "BRIK" the brick grid
+const unsigned int SAVE_BALLS = 0x4C4C4142; // "BALL" the balls pool
+const unsigned int SAVE_COINS = 0x4E494F43; // "COIN" the coins pool
+const unsigned int SAVE_EXPLOSIONS = 0x4C505845; // "EXPL" the explosions pool
+const unsigned int SAVE_BULLETS = 0x544C5542; // "BULT" the bullets pool
+const unsigned int SAVE_TIMERS = 0x524D4954; // "TIMR" the timer wheel
+
+// Structure for reading a save, one chunk of it, or a replay's header or records
+struct SaveReader{
+	const unsigned char *data; // The bytes being read
+	size_t size; // Number of bytes
+	size_t pos; // Next byte to read
+};
+
+void SaveSnapshot(std::vector<unsigned char> &data); // Save the selected game into data, replacing what was there
+bool LoadSnapshot(GameState &state, const unsigned char *data, size_t size); // Load a save into the given game, returns false if it isn't a save of these levels
+bool SaveGameFile(const char *filename); // Save the selected game to a file
+bool LoadGameFile(GameState &state, const char *filename); // Load a game saved to a file into the given game
+
+// The codec shared by saves and replays
+void PutBytes(std::vector<unsigned char> &data, unsigned long long value, int bytes); // Add a number lowest byte first
+unsigned long long TakeBytes(SaveReader &reader, int bytes); // Read a number written by PutBytes (0 past the end)
+void PutVarint(std::vector<unsigned char> &data, unsigned int value); // Add a number 7 bits a byte, small numbers take one byte
+unsigned int TakeVarint(SaveReader &reader); // Read a number written by PutVarint (0 past the end)
+size_t StartChunk(std::vector<unsigned char> &data, unsigned int tag); // Start a chunk, returns where its length goes
+void EndChunk(std::vector<unsigned char> &data, size_t lengthPos); // Fill in the length of the chunk just written
+
+#endif
@@ -0,0 +1,92 @@
+// Timers.cpp
+// The timer wheel that tells the game when a timed effect wears off
+
+// Include the timers header
+#include "timers.h"
+
+// Include the game state header for the wheel of the game being run
+#include "gamestate.h"
+
+void ResetTimers() // Remove every event from the wheel
+{
+	int n; // Counter
+
+	for(n = 0; n < TIMERSLOTS; n++)
+	{
+		game->timerWheel.nearSlots[n].clear();
+		game->timerWheel.farSlots[n].clear();
+	}
+}
+
+void AdvanceTimers() // Move the clock on a game update and fire the events due
+{
+	std::vector<TimerEvent> &firing = game->timerWheel.firing; // Kept between ticks so it doesn't reallocate
+	size_t n; // Counter
+
+	game->gameTick++;
+
+	if((game->gameTick & (TIMERSLOTS - 1)) == 0) // If the near wheel has come round...
+	{
+		// Move the next block of events down from the far wheel, those still further off go back up
+		firing.swap(game->timerWheel.farSlots[(game->gameTick >> TIMERSLOTBITS) & (TIMERSLOTS - 1)]);
+		for(n = 0; n < firing.size(); n++)
+		{
+			ScheduleTimer(firing[n].kind, firing[n].owner, firing[n].due);
+		}
+		firing.clear();
+	}
+
+	// Take the events out of the slot first, as firing one can schedule another
+	firing.swap(game->timerWheel.nearSlots[game->gameTick & (TIMERSLOTS - 1)]);
+	for(n = 0; n < firing.size(); n++)
+	{
+		TimerExpired(firing[n]);
+	}
+	firing.clear();
+}
+
+void ScheduleTimer(int kind, PoolHandle owner, int due) // Add an event for an effect wearing off on tick due
+{
+	TimerEvent event; // The new event
+
+	if(due < game->gameTick) // Effects can't wear off in the past (one due now is only scheduled as the far wheel moves down)
+	{
+		return;
+	}
+	event.due = due;
+	event.kind = kind;
+	event.owner = owner;
+	if(due - game->gameTick < TIMERSLOTS) // If it is due before the near wheel comes round...
+	{
+		game->timerWheel.nearSlots[due & (TIMERSLOTS - 1)].push_back(event);
+	}
+	else
+	{
+		game->timerWheel.farSlots[(due >> TIMERSLOTBITS) & (TIMERSLOTS - 1)].push_back(event);
+	}
+}
+
+int StartTimer(int kind, PoolHandle owner, int ticks) // Returns the tick an effect started now for ticks wears off on, and schedules it
+{
+	if(ticks <= 0) // An effect with no time doesn't run
+	{
+		return 0;
+	}
+	ScheduleTimer(kind, owner, game->gameTick + ticks);
+	return game->gameTick + ticks;
+}
+
+int ExtendTimer(int kind, PoolHandle owner, int due, int ticks) // Returns the tick an effect wearing off on due wears off on after adding ticks, and schedules it
+{
+	if(due <= game->gameTick) // If it isn't running it starts now
+	{
+		return StartTimer(kind, owner, ticks);
+	}
+	ScheduleTimer(kind, owner, due + ticks); // The old event finds the effect still running and is ignored
+	return due + ticks;
+}
+
+int TimeLeft(int due) // Returns the ticks left before an effect wearing off on due wears off
+{
+	return due > game->gameTick ? due - game->gameTick : 0;
+}
@@ -0,0 +1,54 @@
+// Timers.h
+// The timer wheel that tells the game when a timed effect wears off
+// Each timed effect (the magnetic paddle, the lasers, the message on show, the fire, explosive and
+//   no rebound time of each ball and the size of each explosion) is kept as the game tick it wears off on,
+//   with an event for that tick in the wheel, so a game update only does work for the effects that wear off in it
+// The near wheel has a slot for each of the next 256 ticks, and the far wheel a slot for each block of 256 ticks
+//   after that, which is moved down into the near wheel as the near wheel comes round to it
+
+#ifndef TIMERS_H
+#define TIMERS_H
+#pragma once
+
+// Include the game core header for the game objects the timers belong to
+#include "gamecore.h"
+
+// Include standard library
+#include <vector>
+
+// Declare and define constants
+const int TIMERSLOTBITS = 8; // Bits of the game tick used to pick a slot in each wheel
+const int TIMERSLOTS = 1 << TIMERSLOTBITS; // Number of slots in each wheel
+const PoolHandle NOTIMEROWNER = {-1, 0}; // Owner of the effects that don't belong to a ball or explosion
+
+// The timed effects
+const int TIMER_MAGNETIC = 0; // The magnetic paddle
+const int TIMER_LASER = 1; // The laser guns
+const int TIMER_MESSAGE = 2; // The message on show
+const int TIMER_FIRE = 3; // A ball's fire powerup
+const int TIMER_EXPLOSIVE = 4; // A ball's explosive powerup
+const int TIMER_NOREBOUND = 5; // The time after a ball leaves the paddle that it can't hit it again
+const int TIMER_EXPLOSION = 6; // An explosion showing
+
+// Structure for a timed effect wearing off
+struct TimerEvent{
+	int due; // The game tick the effect wears off on
+	int kind; // Which effect it is
+	PoolHandle owner; // The ball or explosion it belongs to (slot -1 for the paddle, lasers and messages)
+};
+
+// Structure for the timer wheel
+struct TimerWheel{
+	std::vector<TimerEvent> nearSlots[TIMERSLOTS]; // Events due in the next 256 ticks, by tick
+	std::vector<TimerEvent> farSlots[TIMERSLOTS]; // Events due later, by block of 256 ticks
+	std::vector<TimerEvent> firing; // The events being fired this tick
+};
+
+void ResetTimers(); // Remove every event from the wheel
+void AdvanceTimers(); // Move the clock on a game update and fire the events due
+void ScheduleTimer(int kind, PoolHandle owner, int due); // Add an event for an effect wearing off on tick due
+int StartTimer(int kind, PoolHandle owner, int ticks); // Returns the tick an effect started now for ticks wears off on, and schedules it
+int ExtendTimer(int kind, PoolHandle owner, int due, int ticks); // Returns the tick an effect wearing off on due (0 = not running) wears off on after adding ticks, and schedules it
+int TimeLeft(int due); // Returns the ticks left before an effect wearing off on due wears off (0 = not running)
+
+#endif